@@ -0,0 +1,63 @@
+/**
+ *  @file collision_stats.h
+ *  @brief Abstract class who defines collision counters operations
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_CORE_COLLISIONSTATS_H_
+#define NEXTFLOOR_CORE_COLLISIONSTATS_H_
+
+namespace nextfloor {
+
+namespace core {
+
+/**
+ *  @class CollisionStats
+ *  @brief Pure interface who defines collision counters operations\n
+ *  Counters are added from any worker and collected from the main loop
+ */
+class CollisionStats {
+
+public:
+    /*
+     *  Timed sub-stages of a level move
+     */
+    static constexpr int kBroadphaseStage = 0;
+    static constexpr int kPairsStage = 1;
+    static constexpr int kNarrowphaseStage = 2;
+    static constexpr int kMoveStage = 3;
+    static constexpr int kActiveObjectsStage = 4;
+    static constexpr int kStagesCount = 5;
+
+    typedef struct {
+        long long candidates;
+        long long eligible_pairs;
+        long long narrow_evaluations;
+        long long hits;
+        long long grid_queries;
+        long long grid_query_boxes;
+        double stage_times[kStagesCount];
+    } Counters;
+
+    virtual ~CollisionStats() = default;
+
+    virtual void Enable() = 0;
+    virtual bool IsEnabled() const = 0;
+
+    virtual void AddCandidates(long long count) = 0;
+    virtual void AddEligiblePairs(long long count) = 0;
+    virtual void AddNarrowEvaluations(long long count) = 0;
+    virtual void AddHits(long long count) = 0;
+    /* One grid neighbors query and the count of boxes it has scanned (fan-out) */
+    virtual void AddGridQuery(long long boxes_count) = 0;
+    virtual void AddStageTime(int stage, double seconds) = 0;
+
+    /* Sum of the counters since last collect, then counters are reset */
+    virtual Counters Collect() = 0;
+};
+
+}  // namespace core
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_CORE_COLLISIONSTATS_H_
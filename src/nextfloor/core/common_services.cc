@@ -21,6 +21,7 @@ CommonServices::CommonServices(const CoreFactory& factory)
     log_ = factory.MakeLog();
     exit_ = factory.MakeExit();
     random_generator_ = factory.MakeRandomGenerator();
+    collision_stats_ = factory.MakeCollisionStats();
 }
 
 ConfigParser* CommonServices::getConfig()
@@ -48,6 +49,11 @@ const Exit* CommonServices::getExit()
     return Instance()->exit();
 }
 
+CollisionStats* CommonServices::getCollisionStats()
+{
+    return Instance()->collision_stats();
+}
+
 CommonServices* CommonServices::Instance()
 {
     static ServicesCoreFactory factory;
@@ -86,6 +92,12 @@ const Exit* CommonServices::exit() const
     return exit_.get();
 }
 
+CollisionStats* CommonServices::collision_stats()
+{
+    assert(collision_stats_ != nullptr);
+    return collision_stats_.get();
+}
+
 }  // namespace core
 
 }  // namespace nextfloor
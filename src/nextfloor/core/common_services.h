@@ -9,6 +9,7 @@
 
 #include <memory>
 
+#include "nextfloor/core/collision_stats.h"
 #include "nextfloor/core/config_parser.h"
 #include "nextfloor/core/file_io.h"
 #include "nextfloor/core/random_generator.h"
@@ -38,6 +39,7 @@ public:
     static const Log* getLog();
     static const RandomGenerator* getRandomGenerator();
     static const Exit* getExit();
+    static CollisionStats* getCollisionStats();
 
 protected:
     CommonServices(const CoreFactory& factory);
@@ -62,12 +64,14 @@ private:
     const Log* log() const;
     const RandomGenerator* random_generator() const;
     const Exit* exit() const;
+    CollisionStats* collision_stats();
 
     std::unique_ptr<ConfigParser> config_{nullptr};
     std::unique_ptr<FileIO> file_io_{nullptr};
     std::unique_ptr<Log> log_{nullptr};
     std::unique_ptr<RandomGenerator> random_generator_{nullptr};
     std::unique_ptr<Exit> exit_{nullptr};
+    std::unique_ptr<CollisionStats> collision_stats_{nullptr};
 };
 
 }  // namespace core
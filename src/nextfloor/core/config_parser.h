@@ -36,8 +36,14 @@ public:
     virtual int getExecutionDuration() const = 0;
     virtual int getDebugLevel() const = 0;
     virtual int getCollisionGranularity() const = 0;
+    virtual int getCollisionSearchType() const = 0;
     virtual int getThreadsCount() const = 0;
     virtual int getParallellAlgoType() const = 0;
+    virtual int getBroadphaseType() const = 0;
+    virtual int getGridStorageType() const = 0;
+    virtual int getGridPlacementType() const = 0;
+    virtual bool isGridTuning() const = 0;
+    virtual int getSimulationRate() const = 0;
     virtual bool IsCollisionDebugEnabled() const = 0;
     virtual bool IsTestDebugEnabled() const = 0;
     virtual bool IsAllDebugEnabled() const = 0;
@@ -9,6 +9,7 @@
 
 #include <memory>
 
+#include "nextfloor/core/collision_stats.h"
 #include "nextfloor/core/config_parser.h"
 #include "nextfloor/core/exit.h"
 #include "nextfloor/core/file_io.h"
@@ -28,6 +29,7 @@ class CoreFactory {
 public:
     virtual ~CoreFactory() = default;
 
+    virtual std::unique_ptr<CollisionStats> MakeCollisionStats() const = 0;
     virtual std::unique_ptr<ConfigParser> MakeConfigParser() const = 0;
     virtual std::unique_ptr<Exit> MakeExit() const = 0;
     virtual std::unique_ptr<FileIO> MakeFileIO() const = 0;
@@ -13,6 +13,8 @@
 
 #include "nextfloor/core/common_services.h"
 #include "nextfloor/physic/nearer_collision_engine.h"
+#include "nextfloor/physic/broadphase.h"
+#include "nextfloor/playground/grid_factory.h"
 
 namespace nextfloor {
 
@@ -55,6 +57,12 @@ void FileConfigParser::InitDefaultValues()
     SetDefaultWidthValueIfEmpty();
     SetDefaultHeightValueIfEmpty();
     SetDefaultCollisionGranularityValueIfEmpty();
+    SetDefaultCollisionSearchValueIfEmpty();
+    SetDefaultBroadphaseValueIfEmpty();
+    SetDefaultGridStorageValueIfEmpty();
+    SetDefaultGridPlacementValueIfEmpty();
+    SetDefaultGridTuningValueIfEmpty();
+    SetDefaultSimulationRateValueIfEmpty();
     SetDefaultVsyncValueIfEmpty();
     SetDefaultGridModeValueIfEmpty();
     SetDefaultDebugVerbosityValueIfEmpty();
@@ -98,6 +106,56 @@ void FileConfigParser::SetDefaultCollisionGranularityValueIfEmpty()
     }
 }
 
+void FileConfigParser::SetDefaultCollisionSearchValueIfEmpty()
+{
+    using nextfloor::physic::NearerCollisionEngine;
+
+    if (!IsExist("collision_search")) {
+        setSetting("collision_search", libconfig::Setting::TypeInt, NearerCollisionEngine::kSearchLinear);
+    }
+}
+
+void FileConfigParser::SetDefaultBroadphaseValueIfEmpty()
+{
+    using nextfloor::physic::Broadphase;
+
+    if (!IsExist("broadphase")) {
+        setSetting("broadphase", libconfig::Setting::TypeInt, Broadphase::kBroadphaseGrid);
+    }
+}
+
+void FileConfigParser::SetDefaultGridStorageValueIfEmpty()
+{
+    using nextfloor::playground::GridFactory;
+
+    if (!IsExist("grid_storage")) {
+        setSetting("grid_storage", libconfig::Setting::TypeInt, GridFactory::kGridStorageNested);
+    }
+}
+
+void FileConfigParser::SetDefaultGridPlacementValueIfEmpty()
+{
+    using nextfloor::playground::GridFactory;
+
+    if (!IsExist("grid_placement")) {
+        setSetting("grid_placement", libconfig::Setting::TypeInt, GridFactory::kGridPlacementOverlap);
+    }
+}
+
+void FileConfigParser::SetDefaultGridTuningValueIfEmpty()
+{
+    if (!IsExist("grid_tuning")) {
+        setSetting("grid_tuning", libconfig::Setting::TypeBoolean, false);
+    }
+}
+
+void FileConfigParser::SetDefaultSimulationRateValueIfEmpty()
+{
+    if (!IsExist("simulation_rate")) {
+        setSetting("simulation_rate", libconfig::Setting::TypeInt, 0);
+    }
+}
+
 void FileConfigParser::SetDefaultVsyncValueIfEmpty()
 {
     if (!IsExist("vsync")) {
@@ -130,10 +188,18 @@ void FileConfigParser::Display() const
 {
     auto count_workers = getThreadsCount();
 
-    std::cout << "Parallell mode (1 -> serial, 2 -> tbb): " << getSetting<int>("parallell") << std::endl;
+    std::cout << "Parallell mode (1 -> serial, 2 -> tbb, 3 -> batch, 4 -> swept): " << getSetting<int>("parallell")
+              << std::endl;
     std::cout << "Window width: " << getSetting<float>("width") << std::endl;
     std::cout << "Window height: " << getSetting<float>("height") << std::endl;
     std::cout << "NearerCollisionEngine granularity: " << getSetting<int>("granularity") << std::endl;
+    std::cout << "Time of impact search (1 -> linear, 2 -> bisection): " << getSetting<int>("collision_search")
+              << std::endl;
+    std::cout << "Broadphase (1 -> grid, 2 -> sweep and prune): " << getSetting<int>("broadphase") << std::endl;
+    std::cout << "Grid storage (1 -> nested, 2 -> flat, 3 -> hash): " << getSetting<int>("grid_storage") << std::endl;
+    std::cout << "Grid placement (1 -> overlap, 2 -> loose): " << getSetting<int>("grid_placement") << std::endl;
+    std::cout << "Grid tuning (room boxes measured at build): " << getSetting<bool>("grid_tuning") << std::endl;
+    std::cout << "Simulation rate (0 -> one step by frame): " << getSetting<int>("simulation_rate") << std::endl;
     std::cout << "Workers count: " << count_workers << std::endl;
     std::cout << "Execution Time (0 -> no limit): " << getSetting<int>("execution_time") << std::endl;
     std::cout << "Vsync (limit framerate to monitor): " << getSetting<bool>("vsync") << std::endl;
@@ -167,10 +233,16 @@ void FileConfigParser::ManageProgramParameters(int argc, char* argv[])
         assert(cnt < argc);
         const std::string parameter_value(argv[cnt++]);
 
+        ManageBroadphaseParameter(parameter_name, parameter_value);
+        ManageGridStorageParameter(parameter_name, parameter_value);
+        ManageGridPlacementParameter(parameter_name, parameter_value);
+        ManageGridTuningParameter(parameter_name, parameter_value);
         ManageDebugParameter(parameter_name, parameter_value);
         ManageExecutionTimeParameter(parameter_name, parameter_value);
         ManageGranularityParameter(parameter_name, parameter_value);
         ManagePrallellAlgoTypeParameter(parameter_name, parameter_value);
+        ManageCollisionSearchParameter(parameter_name, parameter_value);
+        ManageSimulationRateParameter(parameter_name, parameter_value);
         ManageVsyncParameter(parameter_name, parameter_value);
         ManageWorkerCountParameter(parameter_name, parameter_value);
     }
@@ -202,6 +274,13 @@ bool FileConfigParser::IsHelpParameter(const std::string& parameter_name) const
 void FileConfigParser::DisplayHelp(const std::string& command_name) const
 {
     std::cout << command_name << " can be used with following options who overrides config file" << std::endl;
+    std::cout << "-b grid|sap" << std::endl
+              << "       grid: collision neighbors from playground grids" << std::endl
+              << "       sap: persistent sweep and prune" << std::endl;
+    std::cout << "-c nested|flat|hash" << std::endl
+              << "       nested: grid boxes allocated one by one" << std::endl
+              << "       flat: grid boxes into one contiguous array" << std::endl
+              << "       hash: only filled grid boxes allocated, into a hash table" << std::endl;
     std::cout << "-d n   Debug mode, 0: no debug, 1: test debug, 2: performance debug, 3: "
                  "collision debug, 4: all debug"
               << std::endl;
@@ -209,14 +288,82 @@ void FileConfigParser::DisplayHelp(const std::string& command_name) const
     std::cout << "-g n   Granularity on collision computes" << std::endl;
     std::cout << "-h     Display help" << std::endl;
     std::cout << "-l 1|0 Enable/Disable display config" << std::endl;
-    std::cout << "-p serial|tbb" << std::endl
+    std::cout << "-o overlap|loose" << std::endl
+              << "       overlap: meshes into all grid boxes they overlap" << std::endl
+              << "       loose: meshes only into the grid box of their center, queries enlarged" << std::endl;
+    std::cout << "-p serial|tbb|batch|swept" << std::endl
               << "       serial: no parallellism" << std::endl
-              << "       tbb: uses intel tbb library" << std::endl;
+              << "       tbb: uses intel tbb library" << std::endl
+              << "       batch: all pairs of the frame in one swept box pass (granularity unused)" << std::endl
+              << "       swept: analytic swept box test (granularity unused)" << std::endl;
+    std::cout << "-r n   Fixed simulation rate (steps by second), 0: one step by frame" << std::endl;
+    std::cout << "-s linear|bisection" << std::endl
+              << "       linear: time of impact tested at each granularity step" << std::endl
+              << "       bisection: full move first, then bisection in about log2(granularity) steps"
+              << std::endl;
+    std::cout << "-t 1|0 Enable/Disable room grid boxes tuning at build" << std::endl;
     std::cout << "-v 1|0 Enable/Disable vsync" << std::endl;
     std::cout << "-w n   Workers (cpu core) count (disabled if -p serial), "
               << "0: no limit, all cpu cores" << std::endl;
 }
 
+void FileConfigParser::ManageBroadphaseParameter(const std::string& parameter_name, const std::string& parameter_value)
+{
+    using nextfloor::physic::Broadphase;
+
+    if (parameter_name == "-b") {
+        if (parameter_value == "grid") {
+            setSetting("broadphase", libconfig::Setting::TypeInt, Broadphase::kBroadphaseGrid);
+        }
+
+        if (parameter_value == "sap") {
+            setSetting("broadphase", libconfig::Setting::TypeInt, Broadphase::kBroadphaseSweepAndPrune);
+        }
+    }
+}
+
+void FileConfigParser::ManageGridStorageParameter(const std::string& parameter_name, const std::string& parameter_value)
+{
+    using nextfloor::playground::GridFactory;
+
+    if (parameter_name == "-c") {
+        if (parameter_value == "nested") {
+            setSetting("grid_storage", libconfig::Setting::TypeInt, GridFactory::kGridStorageNested);
+        }
+
+        if (parameter_value == "flat") {
+            setSetting("grid_storage", libconfig::Setting::TypeInt, GridFactory::kGridStorageFlat);
+        }
+
+        if (parameter_value == "hash") {
+            setSetting("grid_storage", libconfig::Setting::TypeInt, GridFactory::kGridStorageHash);
+        }
+    }
+}
+
+void FileConfigParser::ManageGridPlacementParameter(const std::string& parameter_name,
+                                                    const std::string& parameter_value)
+{
+    using nextfloor::playground::GridFactory;
+
+    if (parameter_name == "-o") {
+        if (parameter_value == "overlap") {
+            setSetting("grid_placement", libconfig::Setting::TypeInt, GridFactory::kGridPlacementOverlap);
+        }
+
+        if (parameter_value == "loose") {
+            setSetting("grid_placement", libconfig::Setting::TypeInt, GridFactory::kGridPlacementLoose);
+        }
+    }
+}
+
+void FileConfigParser::ManageGridTuningParameter(const std::string& parameter_name, const std::string& parameter_value)
+{
+    if (parameter_name == "-t") {
+        setSetting("grid_tuning", libconfig::Setting::TypeBoolean, std::stoi(parameter_value) == 1);
+    }
+}
+
 void FileConfigParser::ManageDebugParameter(const std::string& parameter_name, const std::string& parameter_value)
 {
     if (parameter_name == "-d") {
@@ -251,6 +398,38 @@ void FileConfigParser::ManagePrallellAlgoTypeParameter(const std::string& parame
         if (parameter_value == "tbb") {
             setSetting("parallell", libconfig::Setting::TypeInt, NearerCollisionEngine::kParallellTbb);
         }
+
+        if (parameter_value == "batch") {
+            setSetting("parallell", libconfig::Setting::TypeInt, NearerCollisionEngine::kParallellBatch);
+        }
+
+        if (parameter_value == "swept") {
+            setSetting("parallell", libconfig::Setting::TypeInt, NearerCollisionEngine::kParallellSwept);
+        }
+    }
+}
+
+void FileConfigParser::ManageCollisionSearchParameter(const std::string& parameter_name,
+                                                      const std::string& parameter_value)
+{
+    using nextfloor::physic::NearerCollisionEngine;
+
+    if (parameter_name == "-s") {
+        if (parameter_value == "linear") {
+            setSetting("collision_search", libconfig::Setting::TypeInt, NearerCollisionEngine::kSearchLinear);
+        }
+
+        if (parameter_value == "bisection") {
+            setSetting("collision_search", libconfig::Setting::TypeInt, NearerCollisionEngine::kSearchBisection);
+        }
+    }
+}
+
+void FileConfigParser::ManageSimulationRateParameter(const std::string& parameter_name,
+                                                     const std::string& parameter_value)
+{
+    if (parameter_name == "-r") {
+        setSetting("simulation_rate", libconfig::Setting::TypeInt, std::stoi(parameter_value));
     }
 }
 
@@ -51,6 +51,8 @@ public:
 
     int getCollisionGranularity() const final { return getSetting<int>("granularity"); }
 
+    int getCollisionSearchType() const final { return getSetting<int>("collision_search"); }
+
     int getThreadsCount() const final
     {
         return getSetting<int>("workers_count") > 0 ? getSetting<int>("workers_count")
@@ -59,6 +61,16 @@ public:
 
     int getParallellAlgoType() const final { return getSetting<int>("parallell"); }
 
+    int getBroadphaseType() const final { return getSetting<int>("broadphase"); }
+
+    int getGridStorageType() const final { return getSetting<int>("grid_storage"); }
+
+    int getGridPlacementType() const final { return getSetting<int>("grid_placement"); }
+
+    bool isGridTuning() const final { return getSetting<bool>("grid_tuning"); }
+
+    int getSimulationRate() const final { return getSetting<int>("simulation_rate"); }
+
     bool IsCollisionDebugEnabled() const final;
     bool IsTestDebugEnabled() const final;
     bool IsAllDebugEnabled() const final;
@@ -98,6 +110,12 @@ private:
     void SetDefaultWidthValueIfEmpty();
     void SetDefaultHeightValueIfEmpty();
     void SetDefaultCollisionGranularityValueIfEmpty();
+    void SetDefaultCollisionSearchValueIfEmpty();
+    void SetDefaultBroadphaseValueIfEmpty();
+    void SetDefaultGridStorageValueIfEmpty();
+    void SetDefaultGridPlacementValueIfEmpty();
+    void SetDefaultGridTuningValueIfEmpty();
+    void SetDefaultSimulationRateValueIfEmpty();
     void SetDefaultVsyncValueIfEmpty();
     void SetDefaultGridModeValueIfEmpty();
     void SetDefaultDebugVerbosityValueIfEmpty();
@@ -109,7 +127,13 @@ private:
     void ManageDebugParameter(const std::string& parameter_name, const std::string& parameter_value);
     void ManageExecutionTimeParameter(const std::string& parameter_name, const std::string& parameter_value);
     void ManageGranularityParameter(const std::string& parameter_name, const std::string& parameter_value);
+    void ManageCollisionSearchParameter(const std::string& parameter_name, const std::string& parameter_value);
     void ManagePrallellAlgoTypeParameter(const std::string& parameter_name, const std::string& parameter_value);
+    void ManageBroadphaseParameter(const std::string& parameter_name, const std::string& parameter_value);
+    void ManageGridStorageParameter(const std::string& parameter_name, const std::string& parameter_value);
+    void ManageGridPlacementParameter(const std::string& parameter_name, const std::string& parameter_value);
+    void ManageGridTuningParameter(const std::string& parameter_name, const std::string& parameter_value);
+    void ManageSimulationRateParameter(const std::string& parameter_name, const std::string& parameter_value);
     void ManageVsyncParameter(const std::string& parameter_name, const std::string& parameter_value);
     void ManageWorkerCountParameter(const std::string& parameter_name, const std::string& parameter_value);
 
@@ -10,11 +10,17 @@
 #include "nextfloor/core/pseudo_random_generator.h"
 #include "nextfloor/core/game_file_io.h"
 #include "nextfloor/core/terminal_log.h"
+#include "nextfloor/core/thread_collision_stats.h"
 
 namespace nextfloor {
 
 namespace core {
 
+std::unique_ptr<CollisionStats> ServicesCoreFactory::MakeCollisionStats() const
+{
+    return std::make_unique<ThreadCollisionStats>();
+}
+
 std::unique_ptr<ConfigParser> ServicesCoreFactory::MakeConfigParser() const
 {
     return std::make_unique<FileConfigParser>();
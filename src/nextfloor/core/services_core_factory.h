@@ -20,6 +20,7 @@ namespace core {
 class ServicesCoreFactory : public CoreFactory {
 
 public:
+    std::unique_ptr<CollisionStats> MakeCollisionStats() const final;
     std::unique_ptr<ConfigParser> MakeConfigParser() const final;
     std::unique_ptr<Exit> MakeExit() const final;
     std::unique_ptr<FileIO> MakeFileIO() const final;
@@ -0,0 +1,83 @@
+/**
+ *  @file thread_collision_stats.cc
+ *  @brief ThreadCollisionStats class file
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#include "nextfloor/core/thread_collision_stats.h"
+
+#include <cassert>
+
+namespace nextfloor {
+
+namespace core {
+
+void ThreadCollisionStats::AddCandidates(long long count)
+{
+    if (is_enabled_) {
+        thread_counters_.local().candidates += count;
+    }
+}
+
+void ThreadCollisionStats::AddEligiblePairs(long long count)
+{
+    if (is_enabled_) {
+        thread_counters_.local().eligible_pairs += count;
+    }
+}
+
+void ThreadCollisionStats::AddNarrowEvaluations(long long count)
+{
+    if (is_enabled_) {
+        thread_counters_.local().narrow_evaluations += count;
+    }
+}
+
+void ThreadCollisionStats::AddHits(long long count)
+{
+    if (is_enabled_) {
+        thread_counters_.local().hits += count;
+    }
+}
+
+void ThreadCollisionStats::AddGridQuery(long long boxes_count)
+{
+    if (is_enabled_) {
+        thread_counters_.local().grid_queries++;
+        thread_counters_.local().grid_query_boxes += boxes_count;
+    }
+}
+
+void ThreadCollisionStats::AddStageTime(int stage, double seconds)
+{
+    assert(stage >= 0 && stage < kStagesCount);
+    if (is_enabled_) {
+        thread_counters_.local().stage_times[stage] += seconds;
+    }
+}
+
+/**
+ *  Must be called outside of a parallel section: slots are read and reset without lock
+ */
+CollisionStats::Counters ThreadCollisionStats::Collect()
+{
+    Counters counters{0, 0, 0, 0, 0, 0, {0.0}};
+    for (auto& local_counters : thread_counters_) {
+        counters.candidates += local_counters.candidates;
+        counters.eligible_pairs += local_counters.eligible_pairs;
+        counters.narrow_evaluations += local_counters.narrow_evaluations;
+        counters.hits += local_counters.hits;
+        counters.grid_queries += local_counters.grid_queries;
+        counters.grid_query_boxes += local_counters.grid_query_boxes;
+        for (auto stage = 0; stage < kStagesCount; stage++) {
+            counters.stage_times[stage] += local_counters.stage_times[stage];
+        }
+        local_counters = Counters{0, 0, 0, 0, 0, 0, {0.0}};
+    }
+
+    return counters;
+}
+
+}  // namespace core
+
+}  // namespace nextfloor
@@ -0,0 +1,55 @@
+/**
+ *  @file thread_collision_stats.h
+ *  @brief ThreadCollisionStats class header
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_CORE_THREADCOLLISIONSTATS_H_
+#define NEXTFLOOR_CORE_THREADCOLLISIONSTATS_H_
+
+#include "nextfloor/core/collision_stats.h"
+
+#include <tbb/tbb.h>
+
+namespace nextfloor {
+
+namespace core {
+
+/**
+ *  @class ThreadCollisionStats
+ *  @brief Collision counters into one slot by thread, no lock or atomic on the hot paths\n
+ *  Counters are ignored until Enable() call
+ */
+class ThreadCollisionStats : public CollisionStats {
+
+public:
+    ThreadCollisionStats() = default;
+    ~ThreadCollisionStats() final = default;
+
+    ThreadCollisionStats(ThreadCollisionStats&&) = delete;
+    ThreadCollisionStats& operator=(ThreadCollisionStats&&) = delete;
+    ThreadCollisionStats(const ThreadCollisionStats&) = delete;
+    ThreadCollisionStats& operator=(const ThreadCollisionStats&) = delete;
+
+    void Enable() final { is_enabled_ = true; }
+    bool IsEnabled() const final { return is_enabled_; }
+
+    void AddCandidates(long long count) final;
+    void AddEligiblePairs(long long count) final;
+    void AddNarrowEvaluations(long long count) final;
+    void AddHits(long long count) final;
+    void AddGridQuery(long long boxes_count) final;
+    void AddStageTime(int stage, double seconds) final;
+
+    Counters Collect() final;
+
+private:
+    bool is_enabled_{false};
+    tbb::enumerable_thread_specific<Counters> thread_counters_{Counters{0, 0, 0, 0, 0, 0, {0.0}}};
+};
+
+}  // namespace core
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_CORE_THREADCOLLISIONSTATS_H_
@@ -48,9 +48,10 @@ std::unique_ptr<Loop> DemoGameFactory::MakeLoop() const
     SceneWindow* game_window = renderer_factory_->GetOrMakeSceneWindow();
     std::unique_ptr<InputHandler> input_handler = hid_factory_->MakeInputHandler();
     std::unique_ptr<Menu> main_menu = menu_factory_->MakeMainMenu();
+    int simulation_rate = nextfloor::core::CommonServices::getConfig()->getSimulationRate();
 
     return std::make_unique<GameLoop>(std::move(level), game_window, std::move(input_handler),
-                                      std::move(timer), std::move(main_menu));
+                                      std::move(timer), std::move(main_menu), simulation_rate);
 }
 
 std::unique_ptr<FrameTimer> DemoGameFactory::MakeFrameTimer() const
@@ -68,13 +69,18 @@ std::unique_ptr<Level> DemoGameFactory::MakeLevel() const
 
     using nextfloor::core::CommonServices;
     int granularity = CommonServices::getConfig()->getCollisionGranularity();
+    int search = CommonServices::getConfig()->getCollisionSearchType();
     int type = CommonServices::getConfig()->getParallellAlgoType();
+    int broadphase_type = CommonServices::getConfig()->getBroadphaseType();
 
     using nextfloor::physic::CollisionEngine;
-    std::unique_ptr<CollisionEngine> collision_engine = collision_engine_factory_->MakeCollisionEngine(type, granularity);
+    std::unique_ptr<CollisionEngine> collision_engine
+      = collision_engine_factory_->MakeCollisionEngine(type, granularity, search);
+    using nextfloor::physic::Broadphase;
+    std::unique_ptr<Broadphase> broadphase = collision_engine_factory_->MakeBroadphase(broadphase_type);
 
-    return std::make_unique<GameLevel>(
-      std::move(universe), std::move(player), std::move(collision_engine), renderer_factory_);
+    return std::make_unique<GameLevel>(std::move(universe), std::move(player), std::move(collision_engine),
+                                       std::move(broadphase), renderer_factory_);
 }
 
 std::unique_ptr<nextfloor::playground::Ground> DemoGameFactory::GenerateUniverseWith3Rooms() const
@@ -7,6 +7,10 @@
 #include "nextfloor/gameplay/game_level.h"
 
 #include <tbb/tbb.h>
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <functional>
 #include <list>
 #include <utility>
 #include <iterator>
@@ -28,6 +32,7 @@ namespace gameplay {
 GameLevel::GameLevel(std::unique_ptr<nextfloor::playground::Ground> universe,
                      std::unique_ptr<nextfloor::element::Element> player,
                      std::unique_ptr<nextfloor::physic::CollisionEngine> collision_engine,
+                     std::unique_ptr<nextfloor::physic::Broadphase> broadphase,
                      RendererFactory* renderer_factory)
 {
     player_ = player.get();
@@ -36,6 +41,7 @@ GameLevel::GameLevel(std::unique_ptr<nextfloor::playground::Ground> universe,
     game_cameras_.push_front(player_->camera());
     SetActiveCamera(player_->camera());
     collision_engine_ = std::move(collision_engine);
+    broadphase_ = std::move(broadphase);
     renderer_factory_ = renderer_factory;
 }
 
@@ -80,38 +86,118 @@ void GameLevel::UpdateElementStates(double elapsed_time)
 
 void GameLevel::Move()
 {
+    using nextfloor::core::CollisionStats;
+
     std::vector<nextfloor::mesh::Mesh*> moving_objects = universe_->GetMovingObjects();
+    RunTimedStage(CollisionStats::kBroadphaseStage, [&]() { broadphase_->Update(universe_.get(), moving_objects); });
     DetectCollision(moving_objects);
-    MoveObjects(moving_objects);
+    RunTimedStage(CollisionStats::kMoveStage, [&]() { MoveObjects(moving_objects); });
+    RunTimedStage(CollisionStats::kActiveObjectsStage, [&]() { universe_->UpdateActiveObjects(); });
+}
+
+void GameLevel::RunTimedStage(int stage, const std::function<void()>& stage_function)
+{
+    using nextfloor::core::CommonServices;
+
+    if (!CommonServices::getCollisionStats()->IsEnabled()) {
+        stage_function();
+        return;
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
+    stage_function();
+    std::chrono::duration<double> stage_duration = std::chrono::steady_clock::now() - start_time;
+    CommonServices::getCollisionStats()->AddStageTime(stage, stage_duration.count());
 }
 
 void GameLevel::DetectCollision(std::vector<nextfloor::mesh::Mesh*> moving_objects)
 {
-    tbb::parallel_for(0, (int)moving_objects.size(), 1, [&](int i) { PivotCollisonOnObject(moving_objects[i]); });
+    using nextfloor::core::CollisionStats;
+    using nextfloor::physic::CollisionPair;
+
+    std::vector<CollisionPair> pairs;
+    RunTimedStage(CollisionStats::kPairsStage, [&]() { pairs = ComputeCollisionPairs(moving_objects); });
+    RunTimedStage(CollisionStats::kNarrowphaseStage, [&]() { collision_engine_->DetectCollision(pairs); });
 }
 
-void GameLevel::PivotCollisonOnObject(nextfloor::mesh::Mesh* pivot)
+std::vector<nextfloor::physic::CollisionPair> GameLevel::ComputeCollisionPairs(
+  const std::vector<nextfloor::mesh::Mesh*>& moving_objects) const
 {
-    std::vector<nextfloor::mesh::Mesh*> test_objects = pivot->FindCollisionNeighbors();
-    tbb::parallel_for(0, (int)test_objects.size(), 1, [&](int i) {
-        assert(pivot->id() != test_objects[i]->id());
-        collision_engine_->DetectCollision(pivot, test_objects[i]);
+    using nextfloor::physic::CollisionPair;
+
+    /* Each pivot fills its own list, no lock needed */
+    std::vector<std::vector<CollisionPair>> pivots_pairs(moving_objects.size());
+    tbb::parallel_for(0, (int)moving_objects.size(), 1, [&](int i) {
+        auto pivot = moving_objects[i];
+        for (auto& neighbor : broadphase_->FindCollisionNeighbors(pivot)) {
+            assert(pivot->id() != neighbor->id());
+            if (pivot->id() < neighbor->id()) {
+                pivots_pairs[i].push_back(CollisionPair{pivot, neighbor, true, false});
+            }
+            else {
+                pivots_pairs[i].push_back(CollisionPair{neighbor, pivot, false, true});
+            }
+        }
+    });
+
+    std::vector<CollisionPair> pairs;
+    for (auto& pivot_pairs : pivots_pairs) {
+        pairs.insert(pairs.end(), pivot_pairs.begin(), pivot_pairs.end());
+    }
+
+    /* Canonical order, then merge a pair seen from its two sides */
+    std::sort(pairs.begin(), pairs.end(), [](const CollisionPair& pair1, const CollisionPair& pair2) {
+        return pair1.first->id() < pair2.first->id()
+               || (pair1.first->id() == pair2.first->id() && pair1.second->id() < pair2.second->id());
     });
+
+    std::vector<CollisionPair> unique_pairs;
+    unique_pairs.reserve(pairs.size());
+    for (auto& pair : pairs) {
+        if (!unique_pairs.empty() && unique_pairs.back().first == pair.first
+            && unique_pairs.back().second == pair.second) {
+            unique_pairs.back().is_first_updated |= pair.is_first_updated;
+            unique_pairs.back().is_second_updated |= pair.is_second_updated;
+        }
+        else {
+            unique_pairs.push_back(pair);
+        }
+    }
+
+    return unique_pairs;
 }
 
 void GameLevel::MoveObjects(std::vector<nextfloor::mesh::Mesh*> moving_objects)
 {
     tbb::parallel_for(0, (int)moving_objects.size(), 1, [&](int i) { moving_objects[i]->MoveLocation(); });
+
+    /* Boundary transferts are batched once all moves are done */
+    universe_->TransfertPendingChilds();
 }
 
 
-void GameLevel::Draw(float window_size_ratio)
+nextfloor::playground::Grid::OccupancyStats GameLevel::CalculateGridStats() const
 {
+    nextfloor::playground::Grid::OccupancyStats stats{{0}, 0, 0, 0, 0, 0};
+    universe_->AddGridOccupancyStats(&stats);
+    return stats;
+}
+
+void GameLevel::Draw(float window_size_ratio, float interpolation)
+{
+    InterpolateMovingObjects(interpolation);
     PrepareDraw(window_size_ratio);
     Renderer(*universe_.get());
     RendererCubeMap(window_size_ratio);
 }
 
+void GameLevel::InterpolateMovingObjects(float interpolation)
+{
+    std::vector<nextfloor::mesh::Mesh*> moving_objects = universe_->GetMovingObjects();
+    tbb::parallel_for(
+      0, (int)moving_objects.size(), 1, [&](int i) { moving_objects[i]->set_interpolation(interpolation); });
+}
+
 void GameLevel::PrepareDraw(float window_size_ratio)
 {
     nextfloor::element::Camera* active_camera = game_cameras_.front();
@@ -9,11 +9,13 @@
 
 #include "nextfloor/gameplay/level.h"
 
+#include <functional>
 #include <memory>
 #include <list>
 
 #include "nextfloor/gameplay/renderer_factory.h"
 #include "nextfloor/physic/collision_engine.h"
+#include "nextfloor/physic/broadphase.h"
 #include "nextfloor/element/element.h"
 #include "nextfloor/playground/ground.h"
 #include "nextfloor/scenery/scenery.h"
@@ -34,6 +36,7 @@ public:
     GameLevel(std::unique_ptr<nextfloor::playground::Ground> universe,
               std::unique_ptr<nextfloor::element::Element> player,
               std::unique_ptr<nextfloor::physic::CollisionEngine> collision_engine,
+              std::unique_ptr<nextfloor::physic::Broadphase> broadphase,
               RendererFactory* renderer_factory);
     ~GameLevel() final = default;
 
@@ -46,15 +49,21 @@ public:
     void ExecutePlayerAction(Action* command) final;
     void UpdateElementStates(double elapsed_time) final;
     void Move() final;
-    void Draw(float window_size_ratio) final;
+    void Draw(float window_size_ratio, float interpolation) final;
+    nextfloor::playground::Grid::OccupancyStats CalculateGridStats() const final;
 
 private:
     void SetActiveCamera(nextfloor::element::Camera* active_camera);
 
+    /* Stage duration is recorded when collision stats are enabled */
+    void RunTimedStage(int stage, const std::function<void()>& stage_function);
+
     void DetectCollision(std::vector<nextfloor::mesh::Mesh*> moving_objects);
-    void PivotCollisonOnObject(nextfloor::mesh::Mesh* pivot);
+    std::vector<nextfloor::physic::CollisionPair> ComputeCollisionPairs(
+      const std::vector<nextfloor::mesh::Mesh*>& moving_objects) const;
     void MoveObjects(std::vector<nextfloor::mesh::Mesh*> moving_objects);
 
+    void InterpolateMovingObjects(float interpolation);
     void PrepareDraw(float window_size_ratio);
     void Renderer(const nextfloor::mesh::Mesh& mesh);
     void RendererCubeMap(float window_size_ratio);
@@ -63,6 +72,7 @@ private:
     nextfloor::element::Element* player_{nullptr};
     std::list<nextfloor::element::Camera*> game_cameras_;
     std::unique_ptr<nextfloor::physic::CollisionEngine> collision_engine_{nullptr};
+    std::unique_ptr<nextfloor::physic::Broadphase> broadphase_{nullptr};
     RendererFactory* renderer_factory_{nullptr};
 };
 
@@ -6,10 +6,13 @@
 
 #include "nextfloor/gameplay/game_loop.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <sstream>
 
 #include "nextfloor/core/common_services.h"
+#include "nextfloor/playground/grid.h"
 
 
 namespace nextfloor {
@@ -20,13 +23,17 @@ namespace {
 
 static bool sInstanciated = false;
 
+/* Same order than CollisionStats stages */
+static const char* sStageNames[] = {"broadphase", "pairs", "narrowphase", "move", "active"};
+
 }  // anonymous namespace
 
 GameLoop::GameLoop(std::unique_ptr<Level> level,
                    SceneWindow* game_window,
                    std::unique_ptr<InputHandler> input_handler,
                    std::unique_ptr<FrameTimer> timer,
-                   std::unique_ptr<Menu> main_menu)
+                   std::unique_ptr<Menu> main_menu,
+                   int simulation_rate)
 {
     assert(!sInstanciated);
     sInstanciated = true;
@@ -36,8 +43,14 @@ GameLoop::GameLoop(std::unique_ptr<Level> level,
     input_handler_ = std::move(input_handler);
     timer_ = std::move(timer);
     main_menu_ = std::move(main_menu);
+    simulation_step_ = simulation_rate > 0 ? 1.0f / simulation_rate : 0.0f;
 
     main_menu_->Init(game_window_->window());
+
+    using nextfloor::core::CommonServices;
+    if (CommonServices::getConfig()->IsCollisionDebugEnabled()) {
+        CommonServices::getCollisionStats()->Enable();
+    }
 }
 
 void GameLoop::RunLoop()
@@ -78,7 +91,13 @@ void GameLoop::RunGame()
 {
     UpdateCameraOrientation();
     HandlerInput();
-    ManageElementStates();
+    if (IsFixedStepMode()) {
+        RunSimulationSteps();
+    }
+    else {
+        ManageElementStates();
+        level_->Move();
+    }
     Draw();
 }
 
@@ -86,7 +105,7 @@ void GameLoop::DisplayMenu()
 {
     HandlerInput();
     game_window_->PrepareDisplay();
-    level_->Draw(game_window_->getWindowRatio());
+    level_->Draw(game_window_->getWindowRatio(), getInterpolation());
     main_menu_->MenuLoop();
     game_window_->SwapBuffers();
 }
@@ -115,11 +134,25 @@ void GameLoop::ManageElementStates()
     level_->UpdateElementStates(timer_->getDeltaTimeSinceLastLoop());
 }
 
+void GameLoop::RunSimulationSteps()
+{
+    step_accumulator_ += timer_->getDeltaTimeSinceLastLoop();
+
+    auto steps_count = 0;
+    while (step_accumulator_ >= simulation_step_ && steps_count++ < kMaxCatchUpSteps) {
+        level_->UpdateElementStates(simulation_step_);
+        level_->Move();
+        step_accumulator_ -= simulation_step_;
+    }
+
+    /* Too slow to catch up: keep only the fraction of a step */
+    step_accumulator_ = std::fmod(step_accumulator_, simulation_step_);
+}
+
 void GameLoop::Draw()
 {
     game_window_->PrepareDisplay();
-    level_->Move();
-    level_->Draw(game_window_->getWindowRatio());
+    level_->Draw(game_window_->getWindowRatio(), getInterpolation());
     game_window_->SwapBuffers();
 }
 
@@ -147,6 +180,11 @@ void GameLoop::LogLoop()
 
         if (CommonServices::getConfig()->IsPerfDebugEnabled()) {
             LogFps();
+            LogGridStats();
+        }
+
+        if (CommonServices::getConfig()->IsCollisionDebugEnabled()) {
+            LogCollisionStats();
         }
 
         CommonServices::getLog()->WriteLine("");
@@ -164,6 +202,54 @@ void GameLoop::LogFps()
     CommonServices::getLog()->Write(std::move(message_fps));
 }
 
+/**
+ *   Collision counters and move sub-stages durations, averaged by frame
+ */
+void GameLoop::LogCollisionStats()
+{
+    using nextfloor::core::CollisionStats;
+    using nextfloor::core::CommonServices;
+
+    CollisionStats::Counters counters = CommonServices::getCollisionStats()->Collect();
+    double frames_count = std::max(timer_->getLoopCountBySecond(), 1);
+
+    std::ostringstream message_collision;
+    message_collision << counters.candidates / frames_count << " candidates - ";
+    message_collision << counters.eligible_pairs / frames_count << " pairs - ";
+    message_collision << counters.narrow_evaluations / frames_count << " narrow tests - ";
+    message_collision << counters.hits / frames_count << " hits - ";
+    message_collision << counters.grid_queries / frames_count << " grid queries - ";
+    message_collision << counters.grid_query_boxes / std::max(counters.grid_queries, 1LL) << " boxes by query - ";
+    for (auto stage = 0; stage < CollisionStats::kStagesCount; stage++) {
+        message_collision << sStageNames[stage] << " " << kMsInSecond * counters.stage_times[stage] / frames_count
+                          << " ms - ";
+    }
+    CommonServices::getLog()->Write(std::move(message_collision));
+}
+
+/**
+ *   Collision grids occupancy: cells by occupants count (last one for larger loads), max load, cells and
+ *   neighbors query boxes by object
+ */
+void GameLoop::LogGridStats()
+{
+    using nextfloor::core::CommonServices;
+    using nextfloor::playground::Grid;
+
+    Grid::OccupancyStats stats = level_->CalculateGridStats();
+    double objects_count = std::max(stats.objects_count, 1LL);
+
+    std::ostringstream message_grid;
+    message_grid << "cells by load";
+    for (auto load = 0; load < Grid::kLoadHistogramSize; load++) {
+        message_grid << " " << stats.load_histogram[load];
+    }
+    message_grid << "+ - max load " << stats.max_load << " - ";
+    message_grid << stats.placements / objects_count << " cells by object - ";
+    message_grid << stats.query_boxes / objects_count << " query boxes by object - ";
+    CommonServices::getLog()->Write(std::move(message_grid));
+}
+
 void GameLoop::PollEvents()
 {
     input_handler_->PollEvents();
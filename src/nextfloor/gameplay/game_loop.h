@@ -32,7 +32,8 @@ public:
              SceneWindow* game_window,
              std::unique_ptr<InputHandler> input_handler,
              std::unique_ptr<FrameTimer> timer,
-             std::unique_ptr<Menu> main_menu);
+             std::unique_ptr<Menu> main_menu,
+             int simulation_rate);
     ~GameLoop() noexcept;
 
     GameLoop(GameLoop&&) = default;
@@ -51,13 +52,19 @@ private:
     static constexpr int kInGameState = 1;
     static constexpr int kInMenuState = 2;
 
+    /* Simulation steps allowed by frame, remaining time is dropped beyond */
+    static constexpr int kMaxCatchUpSteps = 5;
+
     void UpdateTime();
     void UpdateCameraOrientation();
     void HandlerInput();
     void ManageElementStates();
+    void RunSimulationSteps();
     void Draw();
     void LogLoop();
     void LogFps();
+    void LogCollisionStats();
+    void LogGridStats();
     void PollEvents();
     void CheckCurrentState();
     void ApplyLoop();
@@ -68,6 +75,8 @@ private:
     inline bool IsInRunningState() const { return current_state_ != kExitState; }
     inline bool IsInGame() const { return current_state_ == kInGameState; }
     inline bool IsInMenu() const { return current_state_ == kInMenuState; }
+    inline bool IsFixedStepMode() const { return simulation_step_ > 0.0f; }
+    inline float getInterpolation() const { return IsFixedStepMode() ? step_accumulator_ / simulation_step_ : 1.0f; }
 
     std::unique_ptr<InputHandler> input_handler_{nullptr};
     SceneWindow* game_window_{nullptr};
@@ -75,6 +84,10 @@ private:
     std::unique_ptr<Level> level_{nullptr};
     std::unique_ptr<Menu> main_menu_{nullptr};
     int current_state_{kInGameState};
+
+    /* Fixed step duration in seconds (0 -> one variable step by frame) and time not yet simulated */
+    float simulation_step_{0.0f};
+    float step_accumulator_{0.0f};
 };
 
 }  // namespace gameplay
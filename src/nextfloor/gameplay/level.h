@@ -9,6 +9,7 @@
 
 #include "nextfloor/gameplay/hid.h"
 #include "nextfloor/gameplay/action.h"
+#include "nextfloor/playground/grid.h"
 
 namespace nextfloor {
 
@@ -25,9 +26,12 @@ public:
 
     virtual void UpdateCameraOrientation(HIDPointer angles) = 0;
     virtual void Move() = 0;
-    virtual void Draw(float window_size_ratio) = 0;
+    /* Interpolation between the last two simulation steps (1 -> current state) */
+    virtual void Draw(float window_size_ratio, float interpolation) = 0;
     virtual void ExecutePlayerAction(Action* command) = 0;
     virtual void UpdateElementStates(double elapsed_time) = 0;
+    /* Occupancy of the collision grids, summed over all of them */
+    virtual nextfloor::playground::Grid::OccupancyStats CalculateGridStats() const = 0;
 };
 
 }  // namespace gameplay
@@ -0,0 +1,279 @@
+/**
+ *  @file aabb_mesh_tree.cc
+ *  @brief AabbMeshTree class file
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#include "nextfloor/layout/aabb_mesh_tree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
+#include "nextfloor/layout/grid_geometry.h"
+
+namespace nextfloor {
+
+namespace layout {
+
+void AabbMeshTree::Build(const std::vector<nextfloor::mesh::Mesh*>& meshes)
+{
+    std::unique_lock lock(mutex_);
+
+    nodes_.clear();
+    leaf_indexes_.clear();
+    root_ = kNoNode;
+
+    std::vector<Item> items;
+    items.reserve(meshes.size());
+    for (auto& mesh : meshes) {
+        glm::vec3 half_dimension = mesh->dimension() / 2.0f;
+        items.push_back(Item{mesh, mesh->location() - half_dimension, mesh->location() + half_dimension});
+    }
+
+    if (!items.empty()) {
+        nodes_.reserve(2 * items.size() - 1);
+        root_ = BuildNode(&items, 0, items.size(), kNoNode);
+    }
+}
+
+int AabbMeshTree::BuildNode(std::vector<Item>* items, int first, int last, int parent)
+{
+    int node_index = nodes_.size();
+    nodes_.push_back(Node{(*items)[first].min_point, (*items)[first].max_point, kNoNode, kNoNode, parent, nullptr});
+
+    if (last - first == 1) {
+        nodes_[node_index].mesh = (*items)[first].mesh;
+        leaf_indexes_[(*items)[first].mesh] = node_index;
+        return node_index;
+    }
+
+    /* Split at the median of the longest axis of the centers */
+    glm::vec3 min_center = ((*items)[first].min_point + (*items)[first].max_point) / 2.0f;
+    glm::vec3 max_center = min_center;
+    for (auto cnt = first + 1; cnt < last; cnt++) {
+        glm::vec3 center = ((*items)[cnt].min_point + (*items)[cnt].max_point) / 2.0f;
+        min_center = glm::min(min_center, center);
+        max_center = glm::max(max_center, center);
+    }
+
+    glm::vec3 extent = max_center - min_center;
+    int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+    int middle = first + (last - first) / 2;
+    std::nth_element(items->begin() + first, items->begin() + middle, items->begin() + last,
+                     [axis](const Item& item1, const Item& item2) {
+                         return item1.min_point[axis] + item1.max_point[axis]
+                                < item2.min_point[axis] + item2.max_point[axis];
+                     });
+
+    int left = BuildNode(items, first, middle, node_index);
+    int right = BuildNode(items, middle, last, node_index);
+    nodes_[node_index].left = left;
+    nodes_[node_index].right = right;
+    RefitNode(node_index);
+
+    return node_index;
+}
+
+void AabbMeshTree::RefitNode(int node_index)
+{
+    Node& node = nodes_[node_index];
+    node.min_point = glm::min(nodes_[node.left].min_point, nodes_[node.right].min_point);
+    node.max_point = glm::max(nodes_[node.left].max_point, nodes_[node.right].max_point);
+}
+
+void AabbMeshTree::RemoveMesh(nextfloor::mesh::Mesh* mesh)
+{
+    std::unique_lock lock(mutex_);
+
+    auto leaf_it = leaf_indexes_.find(mesh);
+    if (leaf_it == leaf_indexes_.end()) {
+        return;
+    }
+
+    /* Empty leaf box (never overlaps), then refit ancestors */
+    constexpr float kInfinity = std::numeric_limits<float>::infinity();
+    Node& leaf = nodes_[leaf_it->second];
+    leaf.mesh = nullptr;
+    leaf.min_point = glm::vec3(kInfinity);
+    leaf.max_point = glm::vec3(-kInfinity);
+
+    for (auto node_index = leaf.parent; node_index != kNoNode; node_index = nodes_[node_index].parent) {
+        RefitNode(node_index);
+    }
+
+    leaf_indexes_.erase(leaf_it);
+}
+
+std::vector<nextfloor::mesh::Mesh*> AabbMeshTree::FindCollisionNeighbors(const glm::vec3& min_point,
+                                                                         const glm::vec3& max_point) const
+{
+    std::shared_lock lock(mutex_);
+
+    std::vector<nextfloor::mesh::Mesh*> neighbors(0);
+    AddMeshesOverlapping(min_point, max_point, &neighbors);
+    return neighbors;
+}
+
+/**
+ *  Tree bounds are the unpadded ones: meshes are then kept with the padded box of the grids queries
+ */
+void AabbMeshTree::QueryBox(const glm::vec3& min_point,
+                            const glm::vec3& max_point,
+                            std::vector<nextfloor::mesh::Mesh*>* meshes) const
+{
+    int first_mesh = meshes->size();
+    {
+        std::shared_lock lock(mutex_);
+        AddMeshesOverlapping(min_point, max_point, meshes);
+    }
+    KeepMeshesInBox(first_mesh, min_point, max_point, meshes);
+}
+
+void AabbMeshTree::QuerySphere(const glm::vec3& center, float radius, std::vector<nextfloor::mesh::Mesh*>* meshes) const
+{
+    int first_mesh = meshes->size();
+    QueryBox(center - radius, center + radius, meshes);
+    KeepMeshesInSphere(first_mesh, center, radius, meshes);
+}
+
+/**
+ *  Tree meshes further than the k-th buffer mesh cannot be kept: only the sphere up to it is queried
+ */
+void AabbMeshTree::MergeKNearest(const glm::vec3& point,
+                                 int k,
+                                 int first_mesh,
+                                 std::vector<nextfloor::mesh::Mesh*>* meshes) const
+{
+    if (k <= 0) {
+        return;
+    }
+
+    std::vector<nextfloor::mesh::Mesh*> candidates(meshes->begin() + first_mesh, meshes->end());
+    std::vector<float> squared_distances(0);
+    for (auto& candidate : candidates) {
+        squared_distances.push_back(ComputeMeshSquaredDistance(point, *candidate));
+    }
+
+    float radius = std::numeric_limits<float>::infinity();
+    if ((int)candidates.size() >= k) {
+        radius = std::sqrt(*std::max_element(squared_distances.begin(), squared_distances.end()));
+    }
+
+    int first_tree_mesh = candidates.size();
+    QuerySphere(point, radius, &candidates);
+    for (auto cnt = first_tree_mesh; cnt < (int)candidates.size(); cnt++) {
+        squared_distances.push_back(ComputeMeshSquaredDistance(point, *candidates[cnt]));
+    }
+
+    meshes->resize(first_mesh);
+    AddKNearestMeshes(candidates, squared_distances, k, meshes);
+}
+
+void AabbMeshTree::AddMeshesOverlapping(const glm::vec3& min_point,
+                                        const glm::vec3& max_point,
+                                        std::vector<nextfloor::mesh::Mesh*>* meshes) const
+{
+    if (root_ == kNoNode) {
+        return;
+    }
+
+    std::vector<int> pending_nodes{root_};
+    while (!pending_nodes.empty()) {
+        const Node& node = nodes_[pending_nodes.back()];
+        pending_nodes.pop_back();
+
+        if (node.min_point.x > max_point.x || node.max_point.x < min_point.x || node.min_point.y > max_point.y
+            || node.max_point.y < min_point.y || node.min_point.z > max_point.z || node.max_point.z < min_point.z) {
+            continue;
+        }
+
+        if (node.left == kNoNode) {
+            if (node.mesh != nullptr) {
+                meshes->push_back(node.mesh);
+            }
+            continue;
+        }
+
+        pending_nodes.push_back(node.left);
+        pending_nodes.push_back(node.right);
+    }
+}
+
+/**
+ *  Nodes are tested with their (unpadded) bounds, meshes with the padded box of the grids casts
+ */
+AabbMeshTree::RayHit AabbMeshTree::RayCast(const glm::vec3& origin,
+                                           const glm::vec3& direction,
+                                           float max_distance,
+                                           const MeshFilter& filter) const
+{
+    std::shared_lock lock(mutex_);
+
+    RayHit nearer_hit{nullptr, max_distance};
+    if (root_ == kNoNode || direction == glm::vec3(0.0f)) {
+        return nearer_hit;
+    }
+
+    glm::vec3 unit_direction = glm::normalize(direction);
+    std::vector<int> pending_nodes{root_};
+    while (!pending_nodes.empty()) {
+        const Node& node = nodes_[pending_nodes.back()];
+        pending_nodes.pop_back();
+
+        /* Emptied nodes (removed meshes) have min above max */
+        if (node.min_point.x > node.max_point.x) {
+            continue;
+        }
+
+        /* Nodes missed, behind the origin or further than the nearer hit are skipped */
+        glm::vec2 distances = ComputeRayBoxDistances(origin, unit_direction, node.min_point, node.max_point);
+        if (distances.x > distances.y || distances.y < 0.0f || distances.x > nearer_hit.distance) {
+            continue;
+        }
+
+        if (node.left == kNoNode) {
+            if (node.mesh != nullptr && (!filter || filter(*node.mesh))) {
+                UpdateNearerHit(node.mesh, origin, unit_direction, &nearer_hit);
+            }
+            continue;
+        }
+
+        pending_nodes.push_back(node.left);
+        pending_nodes.push_back(node.right);
+    }
+
+    return nearer_hit;
+}
+
+/**
+ *  Same tie break than grids casts: lower id first at the same distance
+ */
+void AabbMeshTree::UpdateNearerHit(nextfloor::mesh::Mesh* mesh,
+                                   const glm::vec3& origin,
+                                   const glm::vec3& direction,
+                                   RayHit* nearer_hit)
+{
+    glm::vec3 first_point = mesh->border()->getFirstPoint();
+    glm::vec3 last_point = mesh->border()->getLastPoint();
+    glm::vec2 distances
+      = ComputeRayBoxDistances(origin, direction, glm::min(first_point, last_point), glm::max(first_point, last_point));
+
+    float hit_distance = std::max(distances.x, 0.0f);
+    if (hit_distance <= distances.y && hit_distance <= nearer_hit->distance) {
+        if (nearer_hit->mesh == nullptr || hit_distance < nearer_hit->distance || mesh->id() < nearer_hit->mesh->id()) {
+            *nearer_hit = RayHit{mesh, hit_distance};
+        }
+    }
+}
+
+int AabbMeshTree::size() const
+{
+    std::shared_lock lock(mutex_);
+    return leaf_indexes_.size();
+}
+
+}  // namespace layout
+
+}  // namespace nextfloor
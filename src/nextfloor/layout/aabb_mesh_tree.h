@@ -0,0 +1,95 @@
+/**
+ *  @file aabb_mesh_tree.h
+ *  @brief AabbMeshTree class header
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_LAYOUT_AABBMESHTREE_H_
+#define NEXTFLOOR_LAYOUT_AABBMESHTREE_H_
+
+#include "nextfloor/playground/mesh_tree.h"
+
+#include <glm/glm.hpp>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace nextfloor {
+
+namespace layout {
+
+/**
+ *  @class AabbMeshTree
+ *  @brief Axis aligned bounding boxes tree, built once (median split on the longest axis)\n
+ *  and refitted when a mesh is removed (queries can run during a removal)
+ */
+class AabbMeshTree : public nextfloor::playground::MeshTree {
+
+public:
+    AabbMeshTree() = default;
+    ~AabbMeshTree() final = default;
+
+    AabbMeshTree(AabbMeshTree&&) = delete;
+    AabbMeshTree& operator=(AabbMeshTree&&) = delete;
+    AabbMeshTree(const AabbMeshTree&) = delete;
+    AabbMeshTree& operator=(const AabbMeshTree&) = delete;
+
+    void Build(const std::vector<nextfloor::mesh::Mesh*>& meshes) final;
+    void RemoveMesh(nextfloor::mesh::Mesh* mesh) final;
+    std::vector<nextfloor::mesh::Mesh*> FindCollisionNeighbors(const glm::vec3& min_point,
+                                                               const glm::vec3& max_point) const final;
+    void QueryBox(const glm::vec3& min_point,
+                  const glm::vec3& max_point,
+                  std::vector<nextfloor::mesh::Mesh*>* meshes) const final;
+    void QuerySphere(const glm::vec3& center, float radius, std::vector<nextfloor::mesh::Mesh*>* meshes) const final;
+    void MergeKNearest(const glm::vec3& point,
+                       int k,
+                       int first_mesh,
+                       std::vector<nextfloor::mesh::Mesh*>* meshes) const final;
+    RayHit RayCast(const glm::vec3& origin,
+                   const glm::vec3& direction,
+                   float max_distance,
+                   const MeshFilter& filter) const final;
+    int size() const final;
+
+private:
+    static constexpr int kNoNode = -1;
+
+    typedef struct {
+        glm::vec3 min_point;
+        glm::vec3 max_point;
+        int left;
+        int right;
+        int parent;
+        /* Only for leafs */
+        nextfloor::mesh::Mesh* mesh;
+    } Node;
+
+    typedef struct {
+        nextfloor::mesh::Mesh* mesh;
+        glm::vec3 min_point;
+        glm::vec3 max_point;
+    } Item;
+
+    int BuildNode(std::vector<Item>* items, int first, int last, int parent);
+    void RefitNode(int node_index);
+    void AddMeshesOverlapping(const glm::vec3& min_point,
+                              const glm::vec3& max_point,
+                              std::vector<nextfloor::mesh::Mesh*>* meshes) const;
+    static void UpdateNearerHit(nextfloor::mesh::Mesh* mesh,
+                                const glm::vec3& origin,
+                                const glm::vec3& direction,
+                                RayHit* nearer_hit);
+
+    std::vector<Node> nodes_;
+    std::unordered_map<nextfloor::mesh::Mesh*, int> leaf_indexes_;
+    int root_{kNoNode};
+    /* Queries share the nodes, build and removals change them */
+    mutable std::shared_mutex mutex_;
+};
+
+}  // namespace layout
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_LAYOUT_AABBMESHTREE_H_
@@ -0,0 +1,109 @@
+/**
+ *  @file flat_grid_box.cc
+ *  @brief FlatGridBox class file
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#include "nextfloor/layout/flat_grid_box.h"
+
+#include <vector>
+#include <cassert>
+
+#include "nextfloor/mesh/mesh.h"
+
+namespace nextfloor {
+
+namespace layout {
+
+void FlatGridBox::set_owner(nextfloor::playground::Grid* owner)
+{
+    owner_ = owner;
+}
+
+void FlatGridBox::add(nextfloor::mesh::Mesh* object)
+{
+    occupants_.add(object);
+}
+
+void FlatGridBox::remove(nextfloor::mesh::Mesh* object)
+{
+    occupants_.remove(object);
+}
+
+void FlatGridBox::clear()
+{
+    occupants_.clear();
+}
+
+bool FlatGridBox::IsInto(const nextfloor::mesh::Mesh& object) const
+{
+    bool is_into = false;
+    occupants_.ForEach([&](nextfloor::mesh::Mesh* occupant) { is_into = is_into || object == *occupant; });
+
+    return is_into;
+}
+
+std::vector<nextfloor::mesh::Mesh*> FlatGridBox::occupants() const
+{
+    std::vector<nextfloor::mesh::Mesh*> occupants;
+    occupants_.ForEach([&](nextfloor::mesh::Mesh* occupant) { occupant->AddLeafsTo(&occupants); });
+
+    return occupants;
+}
+
+void FlatGridBox::AddOccupantsTo(std::vector<nextfloor::mesh::Mesh*>* occupants) const
+{
+    occupants_.ForEach([&](nextfloor::mesh::Mesh* occupant) { occupant->AddLeafsTo(occupants); });
+}
+
+std::vector<nextfloor::mesh::Mesh*> FlatGridBox::other_occupants(const nextfloor::mesh::Mesh& object) const
+{
+    std::vector<nextfloor::mesh::Mesh*> others(0);
+    occupants_.ForEach([&](nextfloor::mesh::Mesh* occupant) {
+        if (occupant->id() != object.id()) {
+            others.push_back(occupant);
+        }
+    });
+
+    return others;
+}
+
+bool FlatGridBox::IsFrontPositionFilled() const
+{
+    assert(owner_ != nullptr);
+    return owner_->IsFrontPositionFilled(coords_);
+}
+
+bool FlatGridBox::IsRightPositionFilled() const
+{
+    assert(owner_ != nullptr);
+    return owner_->IsRightPositionFilled(coords_);
+}
+
+bool FlatGridBox::IsBackPositionFilled() const
+{
+    assert(owner_ != nullptr);
+    return owner_->IsBackPositionFilled(coords_);
+}
+
+bool FlatGridBox::IsLeftPositionFilled() const
+{
+    assert(owner_ != nullptr);
+    return owner_->IsLeftPositionFilled(coords_);
+}
+
+bool FlatGridBox::IsBottomPositionFilled() const
+{
+    assert(owner_ != nullptr);
+    return owner_->IsBottomPositionFilled(coords_);
+}
+
+bool FlatGridBox::IsTopPositionFilled() const
+{
+    assert(owner_ != nullptr);
+    return owner_->IsTopPositionFilled(coords_);
+}
+
+}  // namespace layout
+
+}  // namespace nextfloor
@@ -0,0 +1,74 @@
+/**
+ *  @file flat_grid_box.h
+ *  @brief FlatGridBox class header
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_GRID_FLATGRIDBOX_H_
+#define NEXTFLOOR_GRID_FLATGRIDBOX_H_
+
+#include "nextfloor/mesh/grid_box.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "nextfloor/playground/grid.h"
+#include "nextfloor/mesh/mesh.h"
+#include "nextfloor/layout/grid_box_occupants.h"
+
+namespace nextfloor {
+
+namespace layout {
+
+/**
+ *  @class FlatGridBox
+ *  @brief GridBox designed to be stored into one contiguous array of boxes\n
+ *  Occupants are inline into the box, without heap allocation for most boxes
+ */
+class FlatGridBox : public nextfloor::mesh::GridBox {
+
+public:
+    FlatGridBox() = default;
+    ~FlatGridBox() final = default;
+
+    FlatGridBox(FlatGridBox&&) = delete;
+    FlatGridBox& operator=(FlatGridBox&&) = delete;
+    FlatGridBox(const FlatGridBox&) = delete;
+    FlatGridBox& operator=(const FlatGridBox&) = delete;
+
+    void set_coords(const glm::vec3& coords) { coords_ = coords; }
+
+    void set_owner(nextfloor::playground::Grid* owner) final;
+    void add(nextfloor::mesh::Mesh* object) final;
+    void remove(nextfloor::mesh::Mesh* object) final;
+    void clear() final;
+    std::vector<nextfloor::mesh::Mesh*> other_occupants(const nextfloor::mesh::Mesh& object) const final;
+
+    bool IsInto(const nextfloor::mesh::Mesh& object) const final;
+    bool IsEmpty() const final { return occupants_.size() == 0; }
+    bool IsFilled() const final { return occupants_.size() != 0; }
+
+    bool IsFrontPositionFilled() const final;
+    bool IsRightPositionFilled() const final;
+    bool IsBackPositionFilled() const final;
+    bool IsLeftPositionFilled() const final;
+    bool IsBottomPositionFilled() const final;
+    bool IsTopPositionFilled() const final;
+
+    int size() const final { return occupants_.size(); }
+    glm::vec3 coords() const final { return coords_; }
+
+    std::vector<nextfloor::mesh::Mesh*> occupants() const final;
+    void AddOccupantsTo(std::vector<nextfloor::mesh::Mesh*>* occupants) const final;
+
+private:
+    GridBoxOccupants occupants_;
+    nextfloor::playground::Grid* owner_{nullptr};
+    glm::vec3 coords_{0.0f};
+};
+
+}  // namespace layout
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_GRID_FLATGRIDBOX_H_
@@ -0,0 +1,154 @@
+/**
+ *  @file grid_box_occupants.cc
+ *  @brief GridBoxOccupants class file
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#include "nextfloor/layout/grid_box_occupants.h"
+
+#include <cassert>
+
+namespace nextfloor {
+
+namespace layout {
+
+void GridBoxOccupants::lock() const
+{
+    uint32_t version = version_.load(std::memory_order_relaxed);
+    while ((version & 1) != 0
+           || !version_.compare_exchange_weak(
+             version, version + 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+        version = version_.load(std::memory_order_relaxed);
+    }
+
+    /* Odd version is visible before any write into occupants */
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void GridBoxOccupants::unlock() const
+{
+    version_.fetch_add(1, std::memory_order_release);
+}
+
+void GridBoxOccupants::add(nextfloor::mesh::Mesh* object)
+{
+    assert(object != nullptr);
+
+    lock();
+    if (FindOccupantIndex(*object) == -1) {
+        int count = size_.load(std::memory_order_relaxed);
+        if (count < kInlineOccupantsCount) {
+            inline_occupants_[count].store(object, std::memory_order_relaxed);
+        }
+        else {
+            overflow_occupants_.push_back(object);
+        }
+        size_.store(count + 1, std::memory_order_release);
+    }
+    unlock();
+}
+
+/**
+ *  Last occupant takes the place of the removed one: occupants order is not kept
+ */
+void GridBoxOccupants::remove(nextfloor::mesh::Mesh* object)
+{
+    lock();
+    int index = FindOccupantIndex(*object);
+    if (index != -1) {
+        int count = size_.load(std::memory_order_relaxed);
+        set_occupant(index, occupant(count - 1));
+        if (count > kInlineOccupantsCount) {
+            overflow_occupants_.pop_back();
+        }
+        size_.store(count - 1, std::memory_order_release);
+    }
+    unlock();
+}
+
+void GridBoxOccupants::clear()
+{
+    lock();
+    overflow_occupants_.clear();
+    size_.store(0, std::memory_order_release);
+    unlock();
+}
+
+nextfloor::mesh::Mesh* GridBoxOccupants::occupant(int index) const
+{
+    if (index < kInlineOccupantsCount) {
+        return inline_occupants_[index].load(std::memory_order_relaxed);
+    }
+
+    return overflow_occupants_[index - kInlineOccupantsCount];
+}
+
+void GridBoxOccupants::set_occupant(int index, nextfloor::mesh::Mesh* object)
+{
+    if (index < kInlineOccupantsCount) {
+        inline_occupants_[index].store(object, std::memory_order_relaxed);
+    }
+    else {
+        overflow_occupants_[index - kInlineOccupantsCount] = object;
+    }
+}
+
+/**
+ *  Only called under lock
+ */
+int GridBoxOccupants::FindOccupantIndex(const nextfloor::mesh::Mesh& object) const
+{
+    int count = size_.load(std::memory_order_relaxed);
+    for (auto cnt = 0; cnt < count; cnt++) {
+        if (object == *occupant(cnt)) {
+            return cnt;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ *  Optimistic read, without lock. Returns -1 if occupants are beyond inline storage
+ */
+int GridBoxOccupants::CopyInlineOccupants(InlineOccupants* inline_snapshot) const
+{
+    while (true) {
+        uint32_t version = version_.load(std::memory_order_acquire);
+        if ((version & 1) != 0) {
+            continue;
+        }
+
+        int count = size_.load(std::memory_order_relaxed);
+        if (count > kInlineOccupantsCount) {
+            return -1;
+        }
+
+        for (auto cnt = 0; cnt < count; cnt++) {
+            (*inline_snapshot)[cnt] = inline_occupants_[cnt].load(std::memory_order_relaxed);
+        }
+
+        /* Copies are done before checking that no writer has come meanwhile */
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (version_.load(std::memory_order_relaxed) == version) {
+            return count;
+        }
+    }
+}
+
+std::vector<nextfloor::mesh::Mesh*> GridBoxOccupants::CopyAllOccupants() const
+{
+    lock();
+    int count = size_.load(std::memory_order_relaxed);
+    std::vector<nextfloor::mesh::Mesh*> snapshot(count);
+    for (auto cnt = 0; cnt < count; cnt++) {
+        snapshot[cnt] = occupant(cnt);
+    }
+    unlock();
+
+    return snapshot;
+}
+
+}  // namespace layout
+
+}  // namespace nextfloor
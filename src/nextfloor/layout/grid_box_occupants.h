@@ -0,0 +1,87 @@
+/**
+ *  @file grid_box_occupants.h
+ *  @brief GridBoxOccupants class header
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_GRID_GRIDBOXOCCUPANTS_H_
+#define NEXTFLOOR_GRID_GRIDBOXOCCUPANTS_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "nextfloor/mesh/mesh.h"
+
+namespace nextfloor {
+
+namespace layout {
+
+/**
+ *  @class GridBoxOccupants
+ *  @brief Occupants list of one grid box, safe for concurrent writers and readers\n
+ *  Writers take a spin lock which increments a version (odd while writing).
+ *  Readers copy the inline occupants without lock and retry if the version has changed meanwhile.
+ */
+class GridBoxOccupants {
+
+public:
+    GridBoxOccupants() = default;
+    ~GridBoxOccupants() = default;
+
+    GridBoxOccupants(GridBoxOccupants&&) = delete;
+    GridBoxOccupants& operator=(GridBoxOccupants&&) = delete;
+    GridBoxOccupants(const GridBoxOccupants&) = delete;
+    GridBoxOccupants& operator=(const GridBoxOccupants&) = delete;
+
+    void add(nextfloor::mesh::Mesh* object);
+    void remove(nextfloor::mesh::Mesh* object);
+    void clear();
+
+    int size() const { return size_.load(std::memory_order_acquire); }
+
+    /* Calls visit for each occupant of a consistent snapshot, out of any lock */
+    template <typename Visitor>
+    void ForEach(Visitor visit) const
+    {
+        InlineOccupants inline_snapshot;
+        int count = CopyInlineOccupants(&inline_snapshot);
+        if (count != -1) {
+            for (auto cnt = 0; cnt < count; cnt++) {
+                visit(inline_snapshot[cnt]);
+            }
+            return;
+        }
+
+        for (auto& occupant : CopyAllOccupants()) {
+            visit(occupant);
+        }
+    }
+
+private:
+    /* Most boxes have few occupants, beyond they go to the overflow vector which is read under lock */
+    static constexpr int kInlineOccupantsCount = 4;
+    using InlineOccupants = std::array<nextfloor::mesh::Mesh*, kInlineOccupantsCount>;
+
+    void lock() const;
+    void unlock() const;
+
+    nextfloor::mesh::Mesh* occupant(int index) const;
+    void set_occupant(int index, nextfloor::mesh::Mesh* object);
+    int FindOccupantIndex(const nextfloor::mesh::Mesh& object) const;
+
+    int CopyInlineOccupants(InlineOccupants* inline_snapshot) const;
+    std::vector<nextfloor::mesh::Mesh*> CopyAllOccupants() const;
+
+    std::array<std::atomic<nextfloor::mesh::Mesh*>, kInlineOccupantsCount> inline_occupants_{};
+    std::vector<nextfloor::mesh::Mesh*> overflow_occupants_;
+    std::atomic<int> size_{0};
+    mutable std::atomic<uint32_t> version_{0};
+};
+
+}  // namespace layout
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_GRID_GRIDBOXOCCUPANTS_H_
@@ -0,0 +1,213 @@
+/**
+ *  @file grid_geometry.cc
+ *  @brief Geometry helpers shared by grids
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#include "nextfloor/layout/grid_geometry.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+
+namespace nextfloor {
+
+namespace layout {
+
+namespace {
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+}  // namespace
+
+MeshMarks* MeshMarks::GetClearedMarks()
+{
+    thread_local MeshMarks marks;
+    marks.Clear();
+    return &marks;
+}
+
+void MeshMarks::Clear()
+{
+    marks_count_ = 0;
+
+    /* Epoch 0 is never current: slots are reset only when the counter wraps */
+    if (++epoch_ == 0) {
+        for (auto& slot : slots_) {
+            slot.epoch = 0;
+        }
+        epoch_ = 1;
+    }
+}
+
+bool MeshMarks::Mark(nextfloor::mesh::Mesh* mesh)
+{
+    /* Load is kept under 1/2 */
+    if (2 * (marks_count_ + 1) > (int)slots_.size()) {
+        Grow();
+    }
+
+    int mask = slots_.size() - 1;
+    for (auto index = HashMesh(mesh) & mask; slots_[index].epoch == epoch_; index = (index + 1) & mask) {
+        if (slots_[index].mesh == mesh) {
+            return false;
+        }
+    }
+
+    Insert(mesh);
+    return true;
+}
+
+void MeshMarks::Grow()
+{
+    std::vector<Slot> former_slots = std::move(slots_);
+    slots_.assign(std::max(kMinSlotsCount, 2 * (int)former_slots.size()), Slot{nullptr, 0});
+
+    marks_count_ = 0;
+    for (auto& slot : former_slots) {
+        if (slot.epoch == epoch_) {
+            Insert(slot.mesh);
+        }
+    }
+}
+
+/**
+ *  Mesh is not marked and a free slot exists
+ */
+void MeshMarks::Insert(nextfloor::mesh::Mesh* mesh)
+{
+    int mask = slots_.size() - 1;
+    auto index = HashMesh(mesh) & mask;
+    while (slots_[index].epoch == epoch_) {
+        index = (index + 1) & mask;
+    }
+
+    slots_[index] = Slot{mesh, epoch_};
+    marks_count_++;
+}
+
+int MeshMarks::HashMesh(nextfloor::mesh::Mesh* mesh) const
+{
+    /* Fibonacci hashing of the address, low bits are alignment */
+    uint64_t address = reinterpret_cast<uintptr_t>(mesh) >> 4;
+    return static_cast<int>((address * 0x9E3779B97F4A7C15ull) >> 33);
+}
+
+void KeepUnmarkedMeshes(int first_mesh, MeshMarks* marks, std::vector<nextfloor::mesh::Mesh*>* meshes)
+{
+    int last_mesh = first_mesh;
+    for (auto cnt = first_mesh; cnt < (int)meshes->size(); cnt++) {
+        auto mesh = (*meshes)[cnt];
+        if (marks->Mark(mesh)) {
+            (*meshes)[last_mesh++] = mesh;
+        }
+    }
+    meshes->resize(last_mesh);
+}
+
+bool IsCoordsInRange(const glm::ivec3& coords, const glm::ivec3& min_coords, const glm::ivec3& max_coords)
+{
+    return coords.x >= min_coords.x && coords.x <= max_coords.x && coords.y >= min_coords.y
+           && coords.y <= max_coords.y && coords.z >= min_coords.z && coords.z <= max_coords.z;
+}
+
+glm::vec2 ComputeRayBoxDistances(const glm::vec3& origin,
+                                 const glm::vec3& direction,
+                                 const glm::vec3& min_point,
+                                 const glm::vec3& max_point)
+{
+    glm::vec2 distances(-kInfinity, kInfinity);
+    for (auto axis = 0; axis < 3; axis++) {
+        if (direction[axis] == 0.0f) {
+            if (origin[axis] < min_point[axis] || origin[axis] > max_point[axis]) {
+                return glm::vec2(kInfinity, -kInfinity);
+            }
+            continue;
+        }
+
+        float first_distance = (min_point[axis] - origin[axis]) / direction[axis];
+        float second_distance = (max_point[axis] - origin[axis]) / direction[axis];
+        distances.x = std::max(distances.x, std::min(first_distance, second_distance));
+        distances.y = std::min(distances.y, std::max(first_distance, second_distance));
+    }
+
+    return distances;
+}
+
+float ComputeMeshSquaredDistance(const glm::vec3& point, const nextfloor::mesh::Mesh& mesh)
+{
+    glm::vec3 first_point = mesh.border()->getFirstPoint();
+    glm::vec3 last_point = mesh.border()->getLastPoint();
+    glm::vec3 nearer_point = glm::clamp(point, glm::min(first_point, last_point), glm::max(first_point, last_point));
+    glm::vec3 gap = nearer_point - point;
+    return glm::dot(gap, gap);
+}
+
+void KeepMeshesInBox(int first_mesh,
+                     const glm::vec3& min_point,
+                     const glm::vec3& max_point,
+                     std::vector<nextfloor::mesh::Mesh*>* meshes)
+{
+    int last_mesh = first_mesh;
+    for (auto cnt = first_mesh; cnt < (int)meshes->size(); cnt++) {
+        auto mesh = (*meshes)[cnt];
+        glm::vec3 first_point = mesh->border()->getFirstPoint();
+        glm::vec3 last_point = mesh->border()->getLastPoint();
+        glm::vec3 mesh_min_point = glm::min(first_point, last_point);
+        glm::vec3 mesh_max_point = glm::max(first_point, last_point);
+        if (mesh_min_point.x <= max_point.x && mesh_max_point.x >= min_point.x && mesh_min_point.y <= max_point.y
+            && mesh_max_point.y >= min_point.y && mesh_min_point.z <= max_point.z && mesh_max_point.z >= min_point.z) {
+            (*meshes)[last_mesh++] = mesh;
+        }
+    }
+    meshes->resize(last_mesh);
+}
+
+void KeepMeshesInSphere(int first_mesh,
+                        const glm::vec3& center,
+                        float radius,
+                        std::vector<nextfloor::mesh::Mesh*>* meshes)
+{
+    int last_mesh = first_mesh;
+    for (auto cnt = first_mesh; cnt < (int)meshes->size(); cnt++) {
+        auto mesh = (*meshes)[cnt];
+        if (ComputeMeshSquaredDistance(center, *mesh) <= radius * radius) {
+            (*meshes)[last_mesh++] = mesh;
+        }
+    }
+    meshes->resize(last_mesh);
+}
+
+bool HasKNearestWithin(const std::vector<float>& squared_distances, int k, float squared_distance)
+{
+    auto nearer_count = std::count_if(squared_distances.begin(),
+                                      squared_distances.end(),
+                                      [squared_distance](float distance) { return distance <= squared_distance; });
+    return nearer_count >= k;
+}
+
+void AddKNearestMeshes(const std::vector<nextfloor::mesh::Mesh*>& candidates,
+                       const std::vector<float>& squared_distances,
+                       int k,
+                       std::vector<nextfloor::mesh::Mesh*>* meshes)
+{
+    std::vector<int> indexes(candidates.size());
+    std::iota(indexes.begin(), indexes.end(), 0);
+
+    int nearest_count = std::min(k, (int)candidates.size());
+    std::partial_sort(indexes.begin(), indexes.begin() + nearest_count, indexes.end(), [&](int first, int second) {
+        if (squared_distances[first] != squared_distances[second]) {
+            return squared_distances[first] < squared_distances[second];
+        }
+        return candidates[first]->id() < candidates[second]->id();
+    });
+
+    for (auto cnt = 0; cnt < nearest_count; cnt++) {
+        meshes->push_back(candidates[indexes[cnt]]);
+    }
+}
+
+}  // namespace layout
+
+}  // namespace nextfloor
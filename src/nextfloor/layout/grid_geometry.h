@@ -0,0 +1,109 @@
+/**
+ *  @file grid_geometry.h
+ *  @brief Geometry helpers shared by grids
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_GRID_GRIDGEOMETRY_H_
+#define NEXTFLOOR_GRID_GRIDGEOMETRY_H_
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "nextfloor/mesh/mesh.h"
+
+namespace nextfloor {
+
+namespace layout {
+
+/**
+ *  @class MeshMarks
+ *  @brief Meshes already appended by a query: open addressing set of the calling thread.\n
+ *  Emptied by an epoch increment, no allocation once grown. One query at a time by thread
+ */
+class MeshMarks {
+
+public:
+    /* Marks of the calling thread, emptied for a new query */
+    static MeshMarks* GetClearedMarks();
+
+    /* True if mesh was not marked yet */
+    bool Mark(nextfloor::mesh::Mesh* mesh);
+
+private:
+    static constexpr int kMinSlotsCount = 64;
+
+    /* A slot from another epoch is free */
+    typedef struct {
+        nextfloor::mesh::Mesh* mesh;
+        uint32_t epoch;
+    } Slot;
+
+    void Clear();
+    void Grow();
+    void Insert(nextfloor::mesh::Mesh* mesh);
+    int HashMesh(nextfloor::mesh::Mesh* mesh) const;
+
+    std::vector<Slot> slots_;
+    uint32_t epoch_{0};
+    int marks_count_{0};
+};
+
+/**
+ *  Keeps in order the meshes (from first_mesh) not marked yet, and marks them
+ */
+void KeepUnmarkedMeshes(int first_mesh, MeshMarks* marks, std::vector<nextfloor::mesh::Mesh*>* meshes);
+
+/**
+ *  True if coords are into the boxes range [min_coords, max_coords]
+ */
+bool IsCoordsInRange(const glm::ivec3& coords, const glm::ivec3& min_coords, const glm::ivec3& max_coords);
+
+/**
+ *  Slab test: entry and exit distances of a ray into a box, entry > exit if the ray misses it
+ */
+glm::vec2 ComputeRayBoxDistances(const glm::vec3& origin,
+                                 const glm::vec3& direction,
+                                 const glm::vec3& min_point,
+                                 const glm::vec3& max_point);
+
+/**
+ *  Squared distance from a point to the mesh bounds (padded box of the grid placement), 0 if inside
+ */
+float ComputeMeshSquaredDistance(const glm::vec3& point, const nextfloor::mesh::Mesh& mesh);
+
+/**
+ *  Keeps in order the meshes (from first_mesh) with bounds overlapping the box
+ */
+void KeepMeshesInBox(int first_mesh,
+                     const glm::vec3& min_point,
+                     const glm::vec3& max_point,
+                     std::vector<nextfloor::mesh::Mesh*>* meshes);
+
+/**
+ *  Keeps in order the meshes (from first_mesh) with bounds overlapping the sphere
+ */
+void KeepMeshesInSphere(int first_mesh,
+                        const glm::vec3& center,
+                        float radius,
+                        std::vector<nextfloor::mesh::Mesh*>* meshes);
+
+/**
+ *  True if at least k candidates are not further than squared_distance
+ */
+bool HasKNearestWithin(const std::vector<float>& squared_distances, int k, float squared_distance);
+
+/**
+ *  Appends the k nearer candidates, sorted by distance then by id
+ */
+void AddKNearestMeshes(const std::vector<nextfloor::mesh::Mesh*>& candidates,
+                       const std::vector<float>& squared_distances,
+                       int k,
+                       std::vector<nextfloor::mesh::Mesh*>* meshes);
+
+}  // namespace layout
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_GRID_GRIDGEOMETRY_H_
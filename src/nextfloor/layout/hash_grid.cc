@@ -0,0 +1,838 @@
+/**
+ *  @file hash_grid.cc
+ *  @brief Sparse Grid Implementation class file
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#include "nextfloor/layout/hash_grid.h"
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "nextfloor/core/common_services.h"
+#include "nextfloor/layout/grid_geometry.h"
+
+namespace nextfloor {
+
+namespace layout {
+
+namespace {
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+}  // namespace
+
+HashGrid::HashGrid(const glm::vec3& location, const glm::ivec3& boxes_count, const glm::vec3& box_dimension)
+{
+    location_ = location;
+    boxes_count_ = boxes_count;
+    box_dimension_ = box_dimension;
+    cells_.resize(kMinCellsCount);
+}
+
+glm::vec3 HashGrid::CalculateFirstPointInGrid() const
+{
+    return location_ - box_dimension_ / 2.0f - glm::vec3(width() / 2, height() / 2, depth() / 2);
+}
+
+glm::vec3 HashGrid::CalculateAbsoluteCoordinates(const glm::ivec3& coords) const
+{
+    auto grid0 = CalculateFirstPointInGrid();
+    return grid0 + glm::vec3(coords.x * box_dimension_.x, coords.y * box_dimension_.y, coords.z * box_dimension_.z);
+}
+
+bool HashGrid::IsPositionEmpty(const glm::ivec3& coords) const
+{
+    std::shared_lock lock(mutex_);
+    auto box = FindBox(coords);
+    return box == nullptr || box->IsEmpty();
+}
+
+bool HashGrid::IsPositionFilled(const glm::ivec3& coords) const
+{
+    return !IsPositionEmpty(coords);
+}
+
+bool HashGrid::IsFrontPositionFilled(const glm::ivec3& coords) const
+{
+    return IsPositionFilled(glm::ivec3(coords.x, coords.y, coords.z - 1));
+}
+
+bool HashGrid::IsRightPositionFilled(const glm::ivec3& coords) const
+{
+    return IsPositionFilled(glm::ivec3(coords.x + 1, coords.y, coords.z));
+}
+
+bool HashGrid::IsLeftPositionFilled(const glm::ivec3& coords) const
+{
+    return IsPositionFilled(glm::ivec3(coords.x - 1, coords.y, coords.z));
+}
+
+bool HashGrid::IsBackPositionFilled(const glm::ivec3& coords) const
+{
+    return IsPositionFilled(glm::ivec3(coords.x, coords.y, coords.z + 1));
+}
+
+bool HashGrid::IsBottomPositionFilled(const glm::ivec3& coords) const
+{
+    return IsPositionFilled(glm::ivec3(coords.x, coords.y - 1, coords.z));
+}
+
+bool HashGrid::IsTopPositionFilled(const glm::ivec3& coords) const
+{
+    return IsPositionFilled(glm::ivec3(coords.x, coords.y + 1, coords.z));
+}
+
+int HashGrid::HashCoords(const glm::ivec3& coords) const
+{
+    uint32_t hash = static_cast<uint32_t>(coords.x) * 73856093u ^ static_cast<uint32_t>(coords.y) * 19349663u
+                    ^ static_cast<uint32_t>(coords.z) * 83492791u;
+    return hash & (cells_.size() - 1);
+}
+
+/**
+ *  Linear probing from the hash slot until a free cell
+ */
+int HashGrid::FindCellIndex(const glm::ivec3& coords) const
+{
+    int mask = cells_.size() - 1;
+    for (auto index = HashCoords(coords); cells_[index].box != nullptr; index = (index + 1) & mask) {
+        if (cells_[index].coords == coords) {
+            return index;
+        }
+    }
+
+    return -1;
+}
+
+FlatGridBox* HashGrid::FindBox(const glm::ivec3& coords) const
+{
+    int index = FindCellIndex(coords);
+    return index == -1 ? nullptr : cells_[index].box.get();
+}
+
+FlatGridBox* HashGrid::FindOrAddBox(const glm::ivec3& coords)
+{
+    auto box = FindBox(coords);
+    if (box != nullptr) {
+        return box;
+    }
+
+    if ((used_cells_count_ + 1) * kMaxLoadRatio > (int)cells_.size()) {
+        ResizeCells(cells_.size() * 2);
+    }
+
+    int mask = cells_.size() - 1;
+    auto index = HashCoords(coords);
+    while (cells_[index].box != nullptr) {
+        index = (index + 1) & mask;
+    }
+
+    cells_[index].coords = coords;
+    cells_[index].box = std::make_unique<FlatGridBox>();
+    cells_[index].box->set_coords(coords);
+    cells_[index].box->set_owner(this);
+
+    if (used_cells_count_ == 0) {
+        min_used_coords_ = coords;
+        max_used_coords_ = coords;
+    }
+    min_used_coords_ = glm::min(min_used_coords_, coords);
+    max_used_coords_ = glm::max(max_used_coords_, coords);
+    used_cells_count_++;
+
+    return cells_[index].box.get();
+}
+
+/**
+ *  Backward shift deletion: following cells of the probe sequence are moved back, so no tombstone is needed
+ */
+void HashGrid::RemoveCell(int index)
+{
+    int mask = cells_.size() - 1;
+    cells_[index].box.reset();
+    used_cells_count_--;
+
+    int free_index = index;
+    for (auto next = (index + 1) & mask; cells_[next].box != nullptr; next = (next + 1) & mask) {
+        /* The cell can take the free place only if this one is between its hash slot and itself */
+        int home = HashCoords(cells_[next].coords);
+        if (((next - home) & mask) >= ((next - free_index) & mask)) {
+            cells_[free_index] = std::move(cells_[next]);
+            free_index = next;
+        }
+    }
+
+    if ((int)cells_.size() > kMinCellsCount && used_cells_count_ * kMinLoadRatio < (int)cells_.size()) {
+        ResizeCells(cells_.size() / 2);
+    }
+}
+
+/**
+ *  Boxes are moved with their cell, so grid coords kept by meshes stay valid
+ */
+void HashGrid::ResizeCells(int cells_count)
+{
+    std::vector<Cell> old_cells(std::move(cells_));
+    cells_ = std::vector<Cell>(cells_count);
+    used_cells_count_ = 0;
+
+    int mask = cells_count - 1;
+    for (auto& cell : old_cells) {
+        if (cell.box == nullptr) {
+            continue;
+        }
+
+        auto index = HashCoords(cell.coords);
+        while (cells_[index].box != nullptr) {
+            index = (index + 1) & mask;
+        }
+
+        if (used_cells_count_ == 0) {
+            min_used_coords_ = cell.coords;
+            max_used_coords_ = cell.coords;
+        }
+        min_used_coords_ = glm::min(min_used_coords_, cell.coords);
+        max_used_coords_ = glm::max(max_used_coords_, cell.coords);
+        used_cells_count_++;
+
+        cells_[index] = std::move(cell);
+    }
+}
+
+std::vector<nextfloor::mesh::Mesh*> HashGrid::FindCollisionNeighbors(const glm::vec3& coords) const
+{
+    std::vector<nextfloor::mesh::Mesh*> neighbors(0);
+    FindCollisionNeighbors(coords, &neighbors);
+    return neighbors;
+}
+
+void HashGrid::FindCollisionNeighbors(const glm::vec3& coords, std::vector<nextfloor::mesh::Mesh*>* neighbors) const
+{
+    std::shared_lock lock(mutex_);
+    if (used_cells_count_ == 0) {
+        return;
+    }
+
+    glm::ivec3 center_coords(coords);
+    MeshMarks* marks = MeshMarks::GetClearedMarks();
+    for (auto x = center_coords.x - 1; x <= center_coords.x + 1; x++) {
+        for (auto y = center_coords.y - 1; y <= center_coords.y + 1; y++) {
+            for (auto z = center_coords.z - 1; z <= center_coords.z + 1; z++) {
+                AddOccupantsOfBox(glm::ivec3(x, y, z), marks, neighbors);
+            }
+        }
+    }
+}
+
+/**
+ *  Boxes around the target boxes range, each occupant is appended once.
+ *  Each box of the range is looked up, all are counted as the query fan-out
+ */
+void HashGrid::FindCollisionNeighborsOf(const nextfloor::mesh::Mesh& target,
+                                        std::vector<nextfloor::mesh::Mesh*>* neighbors) const
+{
+    glm::ivec3 min_coords, max_coords;
+    if (!CalculateNeighborsRange(target, &min_coords, &max_coords)) {
+        return;
+    }
+
+    std::shared_lock lock(mutex_);
+    MeshMarks* marks = MeshMarks::GetClearedMarks();
+    for (auto x = min_coords.x; x <= max_coords.x; x++) {
+        for (auto y = min_coords.y; y <= max_coords.y; y++) {
+            for (auto z = min_coords.z; z <= max_coords.z; z++) {
+                AddOccupantsOfBox(glm::ivec3(x, y, z), marks, neighbors);
+            }
+        }
+    }
+
+    glm::ivec3 range_length = max_coords - min_coords + 1;
+    using nextfloor::core::CommonServices;
+    CommonServices::getCollisionStats()->AddGridQuery(range_length.x * range_length.y * range_length.z);
+}
+
+/**
+ *  Target boxes range enlarged by one box, returns false for a target without placement
+ */
+bool HashGrid::CalculateNeighborsRange(const nextfloor::mesh::Mesh& target,
+                                       glm::ivec3* min_coords,
+                                       glm::ivec3* max_coords) const
+{
+    const auto& boxes = target.gridcoords();
+    if (boxes.size() == 0) {
+        return false;
+    }
+
+    *min_coords = glm::ivec3(boxes.front()->coords());
+    *max_coords = *min_coords;
+    for (auto& box : boxes) {
+        *min_coords = glm::min(*min_coords, glm::ivec3(box->coords()));
+        *max_coords = glm::max(*max_coords, glm::ivec3(box->coords()));
+    }
+
+    *min_coords -= glm::ivec3(1);
+    *max_coords += glm::ivec3(1);
+    return true;
+}
+
+/**
+ *  Region is clipped to the allocated boxes bounds
+ */
+void HashGrid::FindCollisionNeighbors(const glm::vec3& min_point,
+                                      const glm::vec3& max_point,
+                                      std::vector<nextfloor::mesh::Mesh*>* neighbors) const
+{
+    std::shared_lock lock(mutex_);
+    if (used_cells_count_ == 0) {
+        return;
+    }
+
+    glm::ivec3 min_coords = glm::max(PointToCoords(min_point) - 1, min_used_coords_);
+    glm::ivec3 max_coords = glm::min(PointToCoords(max_point) + 1, max_used_coords_);
+    MeshMarks* marks = MeshMarks::GetClearedMarks();
+    for (auto x = min_coords.x; x <= max_coords.x; x++) {
+        for (auto y = min_coords.y; y <= max_coords.y; y++) {
+            for (auto z = min_coords.z; z <= max_coords.z; z++) {
+                AddOccupantsOfBox(glm::ivec3(x, y, z), marks, neighbors);
+            }
+        }
+    }
+}
+
+void HashGrid::QueryBox(const glm::vec3& min_point,
+                        const glm::vec3& max_point,
+                        std::vector<nextfloor::mesh::Mesh*>* meshes) const
+{
+    std::shared_lock lock(mutex_);
+    if (used_cells_count_ == 0) {
+        return;
+    }
+
+    glm::ivec3 min_coords = glm::max(PointToCoords(min_point), min_used_coords_);
+    glm::ivec3 max_coords = glm::min(PointToCoords(max_point), max_used_coords_);
+    int first_mesh = meshes->size();
+    MeshMarks* marks = MeshMarks::GetClearedMarks();
+    for (auto x = min_coords.x; x <= max_coords.x; x++) {
+        for (auto y = min_coords.y; y <= max_coords.y; y++) {
+            for (auto z = min_coords.z; z <= max_coords.z; z++) {
+                AddOccupantsOfBox(glm::ivec3(x, y, z), marks, meshes);
+            }
+        }
+    }
+    KeepMeshesInBox(first_mesh, min_point, max_point, meshes);
+}
+
+void HashGrid::QuerySphere(const glm::vec3& center, float radius, std::vector<nextfloor::mesh::Mesh*>* meshes) const
+{
+    int first_mesh = meshes->size();
+    QueryBox(center - radius, center + radius, meshes);
+    KeepMeshesInSphere(first_mesh, center, radius, meshes);
+}
+
+/**
+ *  Rings before the allocated boxes bounds are empty and skipped
+ */
+void HashGrid::QueryKNearest(const glm::vec3& point, int k, std::vector<nextfloor::mesh::Mesh*>* meshes) const
+{
+    std::shared_lock lock(mutex_);
+    if (k <= 0 || used_cells_count_ == 0) {
+        return;
+    }
+
+    glm::ivec3 center_coords = PointToCoords(point);
+    glm::ivec3 first_rings = glm::max(glm::max(min_used_coords_ - center_coords, center_coords - max_used_coords_),
+                                      glm::ivec3(0));
+    glm::ivec3 last_rings = glm::max(center_coords - min_used_coords_, max_used_coords_ - center_coords);
+    int first_ring = std::max(first_rings.x, std::max(first_rings.y, first_rings.z));
+    int last_ring = std::max(last_rings.x, std::max(last_rings.y, last_rings.z));
+
+    std::vector<nextfloor::mesh::Mesh*> candidates(0);
+    std::vector<float> squared_distances(0);
+    MeshMarks* marks = MeshMarks::GetClearedMarks();
+    for (auto ring = first_ring; ring <= last_ring; ring++) {
+        AddOccupantsOfRing(center_coords, ring, marks, &candidates);
+        for (auto cnt = squared_distances.size(); cnt < candidates.size(); cnt++) {
+            squared_distances.push_back(ComputeMeshSquaredDistance(point, *candidates[cnt]));
+        }
+
+        float clearance = CalculateRingClearance(point, center_coords, ring);
+        if (HasKNearestWithin(squared_distances, k, clearance * clearance)) {
+            break;
+        }
+    }
+
+    AddKNearestMeshes(candidates, squared_distances, k, meshes);
+}
+
+/**
+ *  Boxes at chebyshev distance ring from center box, clipped to the allocated boxes bounds
+ */
+void HashGrid::AddOccupantsOfRing(const glm::ivec3& center_coords,
+                                  int ring,
+                                  MeshMarks* marks,
+                                  std::vector<nextfloor::mesh::Mesh*>* neighbors) const
+{
+    glm::ivec3 first_coords = glm::max(center_coords - ring, min_used_coords_);
+    glm::ivec3 last_coords = glm::min(center_coords + ring, max_used_coords_);
+    for (auto x = first_coords.x; x <= last_coords.x; x++) {
+        for (auto y = first_coords.y; y <= last_coords.y; y++) {
+            /* Inside the ring on x and y, only both z ends are on the ring */
+            bool is_ring_row = std::abs(x - center_coords.x) == ring || std::abs(y - center_coords.y) == ring;
+            int z_step = is_ring_row ? 1 : 2 * ring;
+            for (auto z = center_coords.z - ring; z <= center_coords.z + ring; z += z_step) {
+                glm::ivec3 box_coords(x, y, z);
+                if (IsCoordsInRange(box_coords, min_used_coords_, max_used_coords_)) {
+                    AddOccupantsOfBox(box_coords, marks, neighbors);
+                }
+            }
+        }
+    }
+}
+
+/**
+ *  Distance from point under which no mesh can be out of the rings walked.
+ *  Ring sides beyond the allocated boxes bounds bound nothing
+ */
+float HashGrid::CalculateRingClearance(const glm::vec3& point, const glm::ivec3& center_coords, int ring) const
+{
+    glm::vec3 grid0 = CalculateFirstPointInGrid();
+
+    float clearance = kInfinity;
+    for (auto axis = 0; axis < 3; axis++) {
+        if (center_coords[axis] - ring > min_used_coords_[axis]) {
+            float ring_side = grid0[axis] + (center_coords[axis] - ring) * box_dimension_[axis];
+            clearance = std::min(clearance, point[axis] - ring_side);
+        }
+        if (center_coords[axis] + ring < max_used_coords_[axis]) {
+            float ring_side = grid0[axis] + (center_coords[axis] + ring + 1) * box_dimension_[axis];
+            clearance = std::min(clearance, ring_side - point[axis]);
+        }
+    }
+
+    return std::max(clearance, 0.0f);
+}
+
+/**
+ *  Occupants already marked by previous boxes of the query are not appended again
+ */
+void HashGrid::AddOccupantsOfBox(const glm::ivec3& coords,
+                                 MeshMarks* marks,
+                                 std::vector<nextfloor::mesh::Mesh*>* neighbors) const
+{
+    auto box = FindBox(coords);
+    if (box == nullptr) {
+        return;
+    }
+
+    int first_occupant = neighbors->size();
+    box->AddOccupantsTo(neighbors);
+    KeepUnmarkedMeshes(first_occupant, marks, neighbors);
+}
+
+HashGrid::RayHit HashGrid::SegmentCast(const glm::vec3& start_point,
+                                       const glm::vec3& end_point,
+                                       const MeshFilter& filter) const
+{
+    glm::vec3 segment = end_point - start_point;
+    return RayCast(start_point, segment, glm::length(segment), filter);
+}
+
+HashGrid::RayHit HashGrid::RayCast(const glm::vec3& origin,
+                                   const glm::vec3& direction,
+                                   float max_distance,
+                                   const MeshFilter& filter) const
+{
+    RayHit nearer_hit{nullptr, max_distance};
+    std::shared_lock lock(mutex_);
+    if (direction == glm::vec3(0.0f) || used_cells_count_ == 0) {
+        return nearer_hit;
+    }
+
+    glm::vec3 unit_direction = glm::normalize(direction);
+    glm::vec3 grid0 = CalculateFirstPointInGrid();
+    glm::vec3 min_point = grid0 + glm::vec3(min_used_coords_) * box_dimension_;
+    glm::vec3 max_point = grid0 + glm::vec3(max_used_coords_ + 1) * box_dimension_;
+
+    /* Ray is clipped to the allocated boxes */
+    glm::vec2 used_distances = ComputeRayBoxDistances(origin, unit_direction, min_point, max_point);
+    float distance = std::max(used_distances.x, 0.0f);
+    float last_distance = std::min(used_distances.y, max_distance);
+    if (distance > last_distance) {
+        return nearer_hit;
+    }
+
+    glm::ivec3 coords
+      = glm::clamp(PointToCoords(origin + distance * unit_direction), min_used_coords_, max_used_coords_);
+
+    /* Distance to the next box side (max) and between 2 box sides (delta), on each axis */
+    glm::ivec3 step(0);
+    glm::vec3 max_distances(kInfinity);
+    glm::vec3 delta_distances(kInfinity);
+    for (auto axis = 0; axis < 3; axis++) {
+        if (unit_direction[axis] == 0.0f) {
+            continue;
+        }
+
+        step[axis] = unit_direction[axis] > 0.0f ? 1 : -1;
+        float next_side = grid0[axis] + (coords[axis] + (step[axis] > 0 ? 1 : 0)) * box_dimension_[axis];
+        max_distances[axis] = (next_side - origin[axis]) / unit_direction[axis];
+        delta_distances[axis] = box_dimension_[axis] / std::abs(unit_direction[axis]);
+    }
+
+    while (IsCoordsInRange(coords, min_used_coords_, max_used_coords_) && distance <= last_distance) {
+        auto box = FindBox(coords);
+        if (box != nullptr) {
+            FindNearerOccupantOnRay(*box,
+                                    origin,
+                                    unit_direction,
+                                    glm::vec2(std::max(used_distances.x, 0.0f), last_distance),
+                                    filter,
+                                    &nearer_hit);
+        }
+
+        /* A mesh can overlap further boxes: the hit is final only if it is inside the current box */
+        auto axis = 0;
+        if (max_distances.y < max_distances[axis]) {
+            axis = 1;
+        }
+        if (max_distances.z < max_distances[axis]) {
+            axis = 2;
+        }
+        if (nearer_hit.mesh != nullptr && nearer_hit.distance <= max_distances[axis]) {
+            break;
+        }
+
+        distance = max_distances[axis];
+        max_distances[axis] += delta_distances[axis];
+        coords[axis] += step[axis];
+    }
+
+    return nearer_hit;
+}
+
+void HashGrid::FindNearerOccupantOnRay(const FlatGridBox& box,
+                                       const glm::vec3& origin,
+                                       const glm::vec3& direction,
+                                       const glm::vec2& ray_distances,
+                                       const MeshFilter& filter,
+                                       RayHit* nearer_hit) const
+{
+    for (auto& occupant : box.occupants()) {
+        if (filter && !filter(*occupant)) {
+            continue;
+        }
+
+        /* Same padded box than the one used for the grid placement */
+        glm::vec3 first_point = occupant->border()->getFirstPoint();
+        glm::vec3 last_point = occupant->border()->getLastPoint();
+        glm::vec2 distances = ComputeRayBoxDistances(origin,
+                                                     direction,
+                                                     glm::min(first_point, last_point),
+                                                     glm::max(first_point, last_point));
+        float hit_distance = std::max(distances.x, ray_distances.x);
+        if (hit_distance <= std::min(distances.y, ray_distances.y) && hit_distance <= nearer_hit->distance) {
+            if (nearer_hit->mesh == nullptr || hit_distance < nearer_hit->distance
+                || occupant->id() < nearer_hit->mesh->id()) {
+                *nearer_hit = RayHit{occupant, hit_distance};
+            }
+        }
+    }
+}
+
+/**
+ *  Floor and not trunc: coords can be negative out of the nominal bounds
+ */
+glm::ivec3 HashGrid::PointToCoords(const glm::vec3& point) const
+{
+    glm::vec3 coords = glm::floor((point - CalculateFirstPointInGrid()) / box_dimension_);
+    return glm::ivec3(coords);
+}
+
+void HashGrid::CalculatePlacementRange(const nextfloor::mesh::Mesh& object,
+                                       glm::ivec3* min_coords,
+                                       glm::ivec3* max_coords) const
+{
+    auto border = object.border();
+    auto first_coords = PointToCoords(border->getFirstPoint());
+    auto last_coords = PointToCoords(border->getLastPoint());
+    *min_coords = glm::min(first_coords, last_coords);
+    *max_coords = glm::max(first_coords, last_coords);
+}
+
+/**
+ *  Boxes of a placement are listed by ordered coords, so first and last ones bound the range.
+ *  Returns false if the list is not a full range anymore
+ */
+bool HashGrid::FindPlacementRange(const nextfloor::mesh::Mesh& object,
+                                  glm::ivec3* min_coords,
+                                  glm::ivec3* max_coords) const
+{
+    const auto& boxes = object.gridcoords();
+    if (boxes.size() == 0) {
+        return false;
+    }
+
+    glm::ivec3 first_coords(boxes.front()->coords());
+    glm::ivec3 last_coords(boxes.back()->coords());
+    *min_coords = glm::min(first_coords, last_coords);
+    *max_coords = glm::max(first_coords, last_coords);
+
+    glm::ivec3 range_length = *max_coords - *min_coords + 1;
+    return range_length.x * range_length.y * range_length.z == (int)boxes.size();
+}
+
+void HashGrid::AddItem(nextfloor::mesh::Mesh* object)
+{
+    glm::ivec3 min_coords, max_coords;
+    CalculatePlacementRange(*object, &min_coords, &max_coords);
+
+    std::vector<nextfloor::mesh::GridBox*> coords_list;
+    glm::ivec3 range_length = max_coords - min_coords + 1;
+    coords_list.reserve(range_length.x * range_length.y * range_length.z);
+
+    std::unique_lock lock(mutex_);
+    for (auto x = min_coords.x; x <= max_coords.x; x++) {
+        for (auto y = min_coords.y; y <= max_coords.y; y++) {
+            for (auto z = min_coords.z; z <= max_coords.z; z++) {
+                auto box = FindOrAddBox(glm::ivec3(x, y, z));
+                box->add(object);
+                coords_list.push_back(box);
+            }
+        }
+    }
+
+    object->set_gridcoords(coords_list);
+}
+
+/**
+ *  Placement range of the mesh is compared without lock: the table is locked only if boxes have to change
+ */
+void HashGrid::UpdateItem(nextfloor::mesh::Mesh* object)
+{
+    glm::ivec3 min_coords, max_coords;
+    CalculatePlacementRange(*object, &min_coords, &max_coords);
+
+    glm::ivec3 old_min_coords, old_max_coords;
+    if (!FindPlacementRange(*object, &old_min_coords, &old_max_coords)) {
+        RemoveMesh(object);
+        AddItem(object);
+        return;
+    }
+
+    if (min_coords == old_min_coords && max_coords == old_max_coords) {
+        return;
+    }
+
+    std::unique_lock lock(mutex_);
+    for (auto x = old_min_coords.x; x <= old_max_coords.x; x++) {
+        for (auto y = old_min_coords.y; y <= old_max_coords.y; y++) {
+            for (auto z = old_min_coords.z; z <= old_max_coords.z; z++) {
+                if (!IsCoordsInRange(glm::ivec3(x, y, z), min_coords, max_coords)) {
+                    RemoveItemToBox(glm::ivec3(x, y, z), object);
+                }
+            }
+        }
+    }
+
+    std::vector<nextfloor::mesh::GridBox*> coords_list;
+    glm::ivec3 range_length = max_coords - min_coords + 1;
+    coords_list.reserve(range_length.x * range_length.y * range_length.z);
+    for (auto x = min_coords.x; x <= max_coords.x; x++) {
+        for (auto y = min_coords.y; y <= max_coords.y; y++) {
+            for (auto z = min_coords.z; z <= max_coords.z; z++) {
+                glm::ivec3 coords(x, y, z);
+                auto box = FindOrAddBox(coords);
+                if (!IsCoordsInRange(coords, old_min_coords, old_max_coords)) {
+                    box->add(object);
+                }
+                coords_list.push_back(box);
+            }
+        }
+    }
+
+    object->set_gridcoords(coords_list);
+}
+
+void HashGrid::RemoveMesh(nextfloor::mesh::Mesh* object)
+{
+    std::unique_lock lock(mutex_);
+    for (auto& coords : object->coords()) {
+        RemoveItemToBox(coords, object);
+    }
+    object->set_gridcoords(std::vector<nextfloor::mesh::GridBox*>(0));
+}
+
+/**
+ *  An emptied box is freed with its cell
+ */
+void HashGrid::RemoveItemToBox(const glm::ivec3& coords, nextfloor::mesh::Mesh* object)
+{
+    int index = FindCellIndex(coords);
+    if (index == -1) {
+        return;
+    }
+
+    cells_[index].box->remove(object);
+    if (cells_[index].box->IsEmpty()) {
+        RemoveCell(index);
+    }
+}
+
+void HashGrid::set_parent_grid(nextfloor::playground::Grid* parent_grid)
+{
+    if (parent_grid != nullptr) {
+        parent_grid->SetChildGridOccupancy(location_, true);
+    }
+}
+
+void HashGrid::DisplayGrid() const
+{
+    std::shared_lock lock(mutex_);
+    std::cout << "=== HASH GRID Location (" << location_.x << ", " << location_.y << ", " << location_.z << ") "
+              << " ===" << std::endl
+              << used_cells_count_ << " boxes into " << cells_.size() << " cells" << std::endl;
+    for (auto& cell : cells_) {
+        if (cell.box != nullptr) {
+            std::cout << "  (" << cell.coords.x << ", " << cell.coords.y << ", " << cell.coords.z
+                      << "): " << cell.box->size() << std::endl;
+        }
+    }
+    std::cout << std::endl;
+}
+
+/**
+ *  Only allocated boxes are cells here, so no empty cell is counted
+ */
+HashGrid::OccupancyStats HashGrid::CalculateOccupancyStats() const
+{
+    std::shared_lock lock(mutex_);
+    OccupancyStats stats{{0}, 0, 0, 0, 0, 0};
+    std::vector<nextfloor::mesh::Mesh*> objects(0);
+    for (auto& cell : cells_) {
+        if (cell.box != nullptr) {
+            int load = cell.box->size();
+            stats.load_histogram[std::min(load, kLoadHistogramSize - 1)]++;
+            stats.max_load = std::max(stats.max_load, (long long)load);
+            stats.placements += load;
+            cell.box->AddOccupantsTo(&objects);
+        }
+    }
+    stats.cells_count = used_cells_count_;
+
+    sort(objects.begin(), objects.end());
+    objects.erase(unique(objects.begin(), objects.end()), objects.end());
+    stats.objects_count = objects.size();
+    for (auto& object : objects) {
+        glm::ivec3 min_coords, max_coords;
+        if (CalculateNeighborsRange(*object, &min_coords, &max_coords)) {
+            glm::ivec3 range_length = max_coords - min_coords + 1;
+            stats.query_boxes += range_length.x * range_length.y * range_length.z;
+        }
+    }
+
+    return stats;
+}
+
+glm::vec3 HashGrid::CalculateFrontSideLocation() const
+{
+    auto grid0 = CalculateFirstPointInGrid();
+    return grid0 + glm::vec3(width() / 2, height() / 2, 0.0f + kWallPadding);
+}
+
+glm::vec3 HashGrid::CalculateRightSideLocation() const
+{
+    auto grid0 = CalculateFirstPointInGrid();
+    return grid0 + glm::vec3(width() - kWallPadding, height() / 2, depth() / 2);
+}
+
+glm::vec3 HashGrid::CalculateBackSideLocation() const
+{
+    auto grid0 = CalculateFirstPointInGrid();
+    return grid0 + glm::vec3(width() / 2, height() / 2, depth() - kWallPadding);
+}
+
+glm::vec3 HashGrid::CalculateLeftSideLocation() const
+{
+    auto grid0 = CalculateFirstPointInGrid();
+    return grid0 + glm::vec3(0.0f + kWallPadding, height() / 2, depth() / 2);
+}
+
+glm::vec3 HashGrid::CalculateBottomSideLocation() const
+{
+    auto grid0 = CalculateFirstPointInGrid();
+    return grid0 + glm::vec3(width() / 2, 0.0f + kWallPadding, depth() / 2);
+}
+
+glm::vec3 HashGrid::CalculateTopSideLocation() const
+{
+    auto grid0 = CalculateFirstPointInGrid();
+    return grid0 + glm::vec3(width() / 2, height() - kWallPadding, depth() / 2);
+}
+
+glm::vec3 HashGrid::CalculateFrontSideBorderScale() const
+{
+    return glm::vec3(width() / 2, height() / 2, kWallDeepScale);
+}
+
+glm::vec3 HashGrid::CalculateRightSideBorderScale() const
+{
+    return glm::vec3(kWallDeepScale, height() / 2, depth() / 2);
+}
+
+glm::vec3 HashGrid::CalculateBackSideBorderScale() const
+{
+    return glm::vec3(width() / 2, height() / 2, kWallDeepScale);
+}
+
+glm::vec3 HashGrid::CalculateLeftSideBorderScale() const
+{
+    return glm::vec3(kWallDeepScale, height() / 2, depth() / 2);
+}
+
+glm::vec3 HashGrid::CalculateBottomSideBorderScale() const
+{
+    return glm::vec3(width() / 2, kWallDeepScale, depth() / 2);
+}
+
+glm::vec3 HashGrid::CalculateTopSideBorderScale() const
+{
+    return glm::vec3(width() / 2, kWallDeepScale, depth() / 2);
+}
+
+bool HashGrid::IsInside(const glm::vec3& location_object) const
+{
+    auto grid0 = CalculateFirstPointInGrid();
+
+    if (location_object.x < grid0.x + width() && location_object.x >= grid0.x && location_object.y < grid0.y + height()
+        && location_object.y >= grid0.y && location_object.z < grid0.z + depth() && location_object.z >= grid0.z) {
+        return true;
+    }
+
+    return false;
+}
+
+/**
+ *  Boxes are emptied but kept: meshes can still list them
+ */
+void HashGrid::ResetGrid()
+{
+    std::unique_lock lock(mutex_);
+    for (auto& cell : cells_) {
+        if (cell.box != nullptr) {
+            cell.box->clear();
+        }
+    }
+}
+
+}  // namespace layout
+
+}  // namespace nextfloor
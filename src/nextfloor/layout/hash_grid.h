@@ -0,0 +1,182 @@
+/**
+ *  @file hash_grid.h
+ *  @brief HashGrid class header
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_GRID_HASHGRID_H_
+#define NEXTFLOOR_GRID_HASHGRID_H_
+
+#include "nextfloor/playground/grid.h"
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
+#include "nextfloor/mesh/mesh.h"
+#include "nextfloor/layout/flat_grid_box.h"
+#include "nextfloor/layout/grid_geometry.h"
+
+namespace nextfloor {
+
+namespace layout {
+
+/**
+ *  @class HashGrid
+ *  @brief Sparse grid: only boxes with occupants are allocated, into an open addressing hash table of their coords\n
+ *  Boxes count and dimension set the nominal bounds (IsInside, sides), meshes can be placed beyond them
+ */
+class HashGrid : public nextfloor::playground::Grid {
+
+public:
+    HashGrid(const glm::vec3& location, const glm::ivec3& boxes_count, const glm::vec3& box_dimension);
+    ~HashGrid() final = default;
+
+    HashGrid(HashGrid&&) = delete;
+    HashGrid& operator=(HashGrid&&) = delete;
+    HashGrid(const HashGrid&) = delete;
+    HashGrid& operator=(const HashGrid&) = delete;
+
+    bool IsPositionEmpty(const glm::ivec3& coords) const final;
+    bool IsFrontPositionFilled(const glm::ivec3& coords) const final;
+    bool IsRightPositionFilled(const glm::ivec3& coords) const final;
+    bool IsLeftPositionFilled(const glm::ivec3& coords) const final;
+    bool IsBackPositionFilled(const glm::ivec3& coords) const final;
+    bool IsBottomPositionFilled(const glm::ivec3& coords) const final;
+    bool IsTopPositionFilled(const glm::ivec3& coords) const final;
+    bool IsPositionFilled(const glm::ivec3& coords) const final;
+
+    std::vector<nextfloor::mesh::Mesh*> FindCollisionNeighbors(const glm::vec3& coord) const final;
+
+    /* Stencil query: appends the occupants of the 3x3x3 boxes around coord */
+    void FindCollisionNeighbors(const glm::vec3& coord, std::vector<nextfloor::mesh::Mesh*>* neighbors) const final;
+    void FindCollisionNeighborsOf(const nextfloor::mesh::Mesh& target,
+                                  std::vector<nextfloor::mesh::Mesh*>* neighbors) const final;
+    void FindCollisionNeighbors(const glm::vec3& min_point,
+                                const glm::vec3& max_point,
+                                std::vector<nextfloor::mesh::Mesh*>* neighbors) const final;
+
+    void QueryBox(const glm::vec3& min_point,
+                  const glm::vec3& max_point,
+                  std::vector<nextfloor::mesh::Mesh*>* meshes) const final;
+    void QuerySphere(const glm::vec3& center, float radius, std::vector<nextfloor::mesh::Mesh*>* meshes) const final;
+
+    /* Ring expansion clipped to the allocated boxes bounds */
+    void QueryKNearest(const glm::vec3& point, int k, std::vector<nextfloor::mesh::Mesh*>* meshes) const final;
+
+    /* 3D DDA walk clipped to the allocated boxes bounds */
+    RayHit RayCast(const glm::vec3& origin,
+                   const glm::vec3& direction,
+                   float max_distance,
+                   const MeshFilter& filter) const final;
+    RayHit SegmentCast(const glm::vec3& start_point, const glm::vec3& end_point, const MeshFilter& filter) const final;
+
+    glm::vec3 CalculateFirstPointInGrid() const final;
+    glm::vec3 CalculateAbsoluteCoordinates(const glm::ivec3& coords) const final;
+
+    void AddItem(nextfloor::mesh::Mesh* object) final;
+    void UpdateItem(nextfloor::mesh::Mesh* object) final;
+    void RemoveMesh(nextfloor::mesh::Mesh* object) final;
+    bool IsInside(const glm::vec3& location_object) const final;
+
+    /* No occupancy bits: as child, the grid is kept occupied into its parent; as parent, child grids are occupied */
+    void set_parent_grid(nextfloor::playground::Grid* parent_grid) final;
+    void SetChildGridOccupancy(const glm::vec3& child_location, bool is_occupied) final {}
+    bool IsChildGridOccupied(const glm::vec3& child_location) const final { return true; }
+
+    void DisplayGrid() const final;
+    OccupancyStats CalculateOccupancyStats() const final;
+    void ResetGrid() final;
+
+    glm::vec3 CalculateFrontSideLocation() const final;
+    glm::vec3 CalculateRightSideLocation() const final;
+    glm::vec3 CalculateBackSideLocation() const final;
+    glm::vec3 CalculateLeftSideLocation() const final;
+    glm::vec3 CalculateBottomSideLocation() const final;
+    glm::vec3 CalculateTopSideLocation() const final;
+
+    glm::vec3 CalculateFrontSideBorderScale() const final;
+    glm::vec3 CalculateRightSideBorderScale() const final;
+    glm::vec3 CalculateBackSideBorderScale() const final;
+    glm::vec3 CalculateLeftSideBorderScale() const final;
+    glm::vec3 CalculateBottomSideBorderScale() const final;
+    glm::vec3 CalculateTopSideBorderScale() const final;
+
+    glm::vec3 scale() const final { return dimension() / 2.0f; }
+
+    glm::vec3 dimension() const final { return glm::vec3(boxes_count_) * box_dimension_; }
+
+private:
+    static constexpr float kWallPadding = 0.25f;
+    static constexpr float kWallDeepScale = 0.25f;
+
+    /* Cells count is a power of 2, table grows over 1/2 load and shrinks under 1/8 */
+    static constexpr int kMinCellsCount = 64;
+    static constexpr int kMaxLoadRatio = 2;
+    static constexpr int kMinLoadRatio = 8;
+
+    /* A cell without box is free */
+    typedef struct {
+        glm::ivec3 coords;
+        std::unique_ptr<FlatGridBox> box;
+    } Cell;
+
+    int HashCoords(const glm::ivec3& coords) const;
+    int FindCellIndex(const glm::ivec3& coords) const;
+    FlatGridBox* FindBox(const glm::ivec3& coords) const;
+    FlatGridBox* FindOrAddBox(const glm::ivec3& coords);
+    void RemoveItemToBox(const glm::ivec3& coords, nextfloor::mesh::Mesh* object);
+    void RemoveCell(int index);
+    void ResizeCells(int cells_count);
+
+    bool CalculateNeighborsRange(const nextfloor::mesh::Mesh& target,
+                                 glm::ivec3* min_coords,
+                                 glm::ivec3* max_coords) const;
+    void AddOccupantsOfBox(const glm::ivec3& coords,
+                           MeshMarks* marks,
+                           std::vector<nextfloor::mesh::Mesh*>* neighbors) const;
+    void AddOccupantsOfRing(const glm::ivec3& center_coords,
+                            int ring,
+                            MeshMarks* marks,
+                            std::vector<nextfloor::mesh::Mesh*>* neighbors) const;
+    float CalculateRingClearance(const glm::vec3& point, const glm::ivec3& center_coords, int ring) const;
+    void FindNearerOccupantOnRay(const FlatGridBox& box,
+                                 const glm::vec3& origin,
+                                 const glm::vec3& direction,
+                                 const glm::vec2& ray_distances,
+                                 const MeshFilter& filter,
+                                 RayHit* nearer_hit) const;
+
+    glm::ivec3 PointToCoords(const glm::vec3& point) const;
+    void CalculatePlacementRange(const nextfloor::mesh::Mesh& object,
+                                 glm::ivec3* min_coords,
+                                 glm::ivec3* max_coords) const;
+    bool FindPlacementRange(const nextfloor::mesh::Mesh& object, glm::ivec3* min_coords, glm::ivec3* max_coords) const;
+
+    float width() const { return boxes_count_.x * box_dimension_.x; }
+
+    float height() const { return boxes_count_.y * box_dimension_.y; }
+
+    float depth() const { return boxes_count_.z * box_dimension_.z; }
+
+    std::vector<Cell> cells_;
+    int used_cells_count_{0};
+
+    /* Bounds of the allocated boxes, only grown between 2 table resizes */
+    glm::ivec3 min_used_coords_{0};
+    glm::ivec3 max_used_coords_{-1};
+
+    glm::vec3 box_dimension_;
+    glm::vec3 location_;
+    glm::ivec3 boxes_count_;
+
+    /* Queries share the table, placements change it */
+    mutable std::shared_mutex mutex_;
+};
+
+}  // namespace layout
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_GRID_HASHGRID_H_
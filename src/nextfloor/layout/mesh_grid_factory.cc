@@ -10,8 +10,12 @@
 #include <memory>
 
 #include "nextfloor/mesh/grid_box.h"
+#include "nextfloor/core/common_services.h"
 
+#include "nextfloor/layout/aabb_mesh_tree.h"
+#include "nextfloor/layout/hash_grid.h"
 #include "nextfloor/layout/room_grid.h"
+#include "nextfloor/layout/room_grid_tuner.h"
 #include "nextfloor/layout/universe_grid.h"
 #include "nextfloor/layout/wired_grid_box.h"
 
@@ -21,17 +25,85 @@ namespace layout {
 
 std::unique_ptr<nextfloor::playground::Grid> MeshGridFactory::MakeUniverseGrid(const glm::vec3& location) const
 {
-    return std::make_unique<UniverseGrid>(
-      location,
-      GenerateBoxes(UniverseGrid::kWidthBoxesCount, UniverseGrid::kHeightBoxesCount, UniverseGrid::kDepthBoxesCount));
+    /* Hash grid has only overlap placement */
+    if (grid_storage_type() == kGridStorageHash) {
+        return std::make_unique<HashGrid>(
+          location,
+          glm::ivec3(UniverseGrid::kWidthBoxesCount, UniverseGrid::kHeightBoxesCount, UniverseGrid::kDepthBoxesCount),
+          glm::vec3(UniverseGrid::kBoxWidth, UniverseGrid::kBoxHeight, UniverseGrid::kBoxDepth));
+    }
+
+    std::unique_ptr<UniverseGrid> grid{nullptr};
+    if (grid_storage_type() == kGridStorageFlat) {
+        grid = std::make_unique<UniverseGrid>(location,
+                                              GenerateFlatBoxes(UniverseGrid::kWidthBoxesCount,
+                                                                UniverseGrid::kHeightBoxesCount,
+                                                                UniverseGrid::kDepthBoxesCount));
+    }
+    else {
+        grid = std::make_unique<UniverseGrid>(location,
+                                              GenerateBoxes(UniverseGrid::kWidthBoxesCount,
+                                                            UniverseGrid::kHeightBoxesCount,
+                                                            UniverseGrid::kDepthBoxesCount));
+    }
+
+    if (grid_placement_type() == kGridPlacementLoose) {
+        grid->EnableLoosePlacement();
+    }
+
+    return grid;
 }
 
 std::unique_ptr<nextfloor::playground::Grid> MeshGridFactory::MakeRoomGrid(const glm::vec3& location) const
 {
-    return std::make_unique<RoomGrid>(
-      location, GenerateBoxes(RoomGrid::kWidthBoxesCount, RoomGrid::kHeightBoxesCount, RoomGrid::kDepthBoxesCount));
+    return MakeRoomGridWithBoxes(
+      location, glm::ivec3(RoomGrid::kWidthBoxesCount, RoomGrid::kHeightBoxesCount, RoomGrid::kDepthBoxesCount));
+}
+
+std::unique_ptr<nextfloor::playground::Grid> MeshGridFactory::MakeRoomGrid(
+  const glm::vec3& location,
+  const std::vector<nextfloor::mesh::Mesh*>& meshes) const
+{
+    if (!is_grid_tuning()) {
+        return MakeRoomGrid(location);
+    }
+
+    RoomGridTuner tuner(grid_placement_type() == kGridPlacementLoose);
+    return MakeRoomGridWithBoxes(location, tuner.FindBoxesCount(location, meshes));
+}
+
+std::unique_ptr<nextfloor::playground::Grid> MeshGridFactory::MakeRoomGridWithBoxes(
+  const glm::vec3& location,
+  const glm::ivec3& boxes_count) const
+{
+    /* Hash grid has only overlap placement */
+    if (grid_storage_type() == kGridStorageHash) {
+        return std::make_unique<HashGrid>(RoomGrid::CalculateGridLocation(location, boxes_count),
+                                          boxes_count,
+                                          RoomGrid::CalculateBoxDimension(boxes_count));
+    }
+
+    std::unique_ptr<RoomGrid> grid{nullptr};
+    if (grid_storage_type() == kGridStorageFlat) {
+        grid = std::make_unique<RoomGrid>(
+          location, boxes_count, GenerateFlatBoxes(boxes_count.x, boxes_count.y, boxes_count.z));
+    }
+    else {
+        grid = std::make_unique<RoomGrid>(
+          location, boxes_count, GenerateBoxes(boxes_count.x, boxes_count.y, boxes_count.z));
+    }
+
+    if (grid_placement_type() == kGridPlacementLoose) {
+        grid->EnableLoosePlacement();
+    }
+
+    return grid;
 }
 
+std::unique_ptr<nextfloor::playground::MeshTree> MeshGridFactory::MakeMeshTree() const
+{
+    return std::make_unique<AabbMeshTree>();
+}
 
 std::unique_ptr<nextfloor::mesh::GridBox>*** MeshGridFactory::GenerateBoxes(unsigned int grid_width,
                                                                             unsigned int grid_height,
@@ -54,6 +126,34 @@ std::unique_ptr<nextfloor::mesh::GridBox>*** MeshGridFactory::GenerateBoxes(unsi
     return boxes;
 }
 
+int MeshGridFactory::grid_storage_type() const
+{
+    using nextfloor::core::CommonServices;
+    return CommonServices::getConfig()->getGridStorageType();
+}
+
+int MeshGridFactory::grid_placement_type() const
+{
+    using nextfloor::core::CommonServices;
+    return CommonServices::getConfig()->getGridPlacementType();
+}
+
+bool MeshGridFactory::is_grid_tuning() const
+{
+    using nextfloor::core::CommonServices;
+    return CommonServices::getConfig()->isGridTuning();
+}
+
+/**
+ *  Boxes are set (coords and owner) by the grid, which knows the linear indexation
+ */
+std::unique_ptr<FlatGridBox[]> MeshGridFactory::GenerateFlatBoxes(unsigned int grid_width,
+                                                                  unsigned int grid_height,
+                                                                  unsigned int grid_depth) const
+{
+    return std::make_unique<FlatGridBox[]>(grid_width * grid_height * grid_depth);
+}
+
 std::unique_ptr<nextfloor::mesh::GridBox> MeshGridFactory::MakeGridBox(const glm::ivec3& coords) const
 {
     return std::make_unique<WiredGridBox>(coords);
@@ -12,6 +12,7 @@
 #include <memory>
 
 #include "nextfloor/mesh/grid_box.h"
+#include "nextfloor/layout/flat_grid_box.h"
 
 namespace nextfloor {
 
@@ -26,9 +27,21 @@ class MeshGridFactory : public nextfloor::playground::GridFactory {
 public:
     std::unique_ptr<nextfloor::playground::Grid> MakeUniverseGrid(const glm::vec3& location) const final;
     std::unique_ptr<nextfloor::playground::Grid> MakeRoomGrid(const glm::vec3& location) const final;
+    std::unique_ptr<nextfloor::playground::Grid> MakeRoomGrid(
+      const glm::vec3& location,
+      const std::vector<nextfloor::mesh::Mesh*>& meshes) const final;
+    std::unique_ptr<nextfloor::playground::MeshTree> MakeMeshTree() const final;
 
 private:
+    int grid_storage_type() const;
+    int grid_placement_type() const;
+    bool is_grid_tuning() const;
+    std::unique_ptr<nextfloor::playground::Grid> MakeRoomGridWithBoxes(const glm::vec3& location,
+                                                                       const glm::ivec3& boxes_count) const;
     std::unique_ptr<nextfloor::mesh::GridBox> MakeGridBox(const glm::ivec3& grid_coords) const;
+    std::unique_ptr<FlatGridBox[]> GenerateFlatBoxes(unsigned int grid_width,
+                                                     unsigned int grid_height,
+                                                     unsigned int grid_depth) const;
     std::unique_ptr<nextfloor::mesh::GridBox>*** GenerateBoxes(unsigned int grid_width,
                                                                unsigned int grid_height,
                                                                unsigned int grid_depth) const;
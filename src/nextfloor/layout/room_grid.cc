@@ -20,6 +20,48 @@ RoomGrid::RoomGrid(const glm::vec3& location, std::unique_ptr<nextfloor::mesh::G
                   std::move(boxes))
 {}
 
+RoomGrid::RoomGrid(const glm::vec3& location, std::unique_ptr<FlatGridBox[]> flat_boxes)
+      : WiredGrid(location,
+                  glm::ivec3(kWidthBoxesCount, kHeightBoxesCount, kDepthBoxesCount),
+                  glm::vec3(kBoxWidth, kBoxHeight, kBoxDepth),
+                  std::move(flat_boxes))
+{}
+
+RoomGrid::RoomGrid(const glm::vec3& location,
+                   const glm::ivec3& boxes_count,
+                   std::unique_ptr<nextfloor::mesh::GridBox>*** boxes)
+      : WiredGrid(CalculateGridLocation(location, boxes_count),
+                  boxes_count,
+                  CalculateBoxDimension(boxes_count),
+                  std::move(boxes))
+{}
+
+RoomGrid::RoomGrid(const glm::vec3& location,
+                   const glm::ivec3& boxes_count,
+                   std::unique_ptr<FlatGridBox[]> flat_boxes)
+      : WiredGrid(CalculateGridLocation(location, boxes_count),
+                  boxes_count,
+                  CalculateBoxDimension(boxes_count),
+                  std::move(flat_boxes))
+{}
+
+glm::vec3 RoomGrid::CalculateBoxDimension(const glm::ivec3& boxes_count)
+{
+    glm::vec3 room_dimension = glm::vec3(kWidthBoxesCount * kBoxWidth,
+                                         kHeightBoxesCount * kBoxHeight,
+                                         kDepthBoxesCount * kBoxDepth);
+    return room_dimension / glm::vec3(boxes_count);
+}
+
+/**
+ *  Grid first point is shifted by half a box: location is moved so that walls and room bounds stay in place
+ */
+glm::vec3 RoomGrid::CalculateGridLocation(const glm::vec3& location, const glm::ivec3& boxes_count)
+{
+    glm::vec3 default_box_dimension(kBoxWidth, kBoxHeight, kBoxDepth);
+    return location + (CalculateBoxDimension(boxes_count) - default_box_dimension) / 2.0f;
+}
+
 RoomGrid::~RoomGrid() noexcept
 {
     DeleteGrid();
@@ -13,6 +13,7 @@
 #include <memory>
 
 #include "nextfloor/mesh/grid_box.h"
+#include "nextfloor/layout/flat_grid_box.h"
 
 namespace nextfloor {
 
@@ -36,7 +37,17 @@ public:
     static constexpr float kBoxDepth = 2.0f;
 
     RoomGrid(const glm::vec3& location, std::unique_ptr<nextfloor::mesh::GridBox>*** boxes);
+    RoomGrid(const glm::vec3& location, std::unique_ptr<FlatGridBox[]> flat_boxes);
+
+    /* Tuned boxes: same room dimension cut into boxes_count, grid first point is kept */
+    RoomGrid(const glm::vec3& location,
+             const glm::ivec3& boxes_count,
+             std::unique_ptr<nextfloor::mesh::GridBox>*** boxes);
+    RoomGrid(const glm::vec3& location, const glm::ivec3& boxes_count, std::unique_ptr<FlatGridBox[]> flat_boxes);
     ~RoomGrid() noexcept final;
+
+    static glm::vec3 CalculateBoxDimension(const glm::ivec3& boxes_count);
+    static glm::vec3 CalculateGridLocation(const glm::vec3& location, const glm::ivec3& boxes_count);
 };
 
 }  // namespace layout
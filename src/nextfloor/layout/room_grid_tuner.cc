@@ -0,0 +1,100 @@
+/**
+ *  @file room_grid_tuner.cc
+ *  @brief RoomGridTuner class file
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#include "nextfloor/layout/room_grid_tuner.h"
+
+#include <memory>
+
+#include "nextfloor/mesh/grid_box.h"
+#include "nextfloor/layout/flat_grid_box.h"
+
+namespace nextfloor {
+
+namespace layout {
+
+RoomGridTuner::RoomGridTuner(bool is_loose_placement)
+{
+    is_loose_placement_ = is_loose_placement;
+}
+
+glm::ivec3 RoomGridTuner::FindBoxesCount(const glm::vec3& location,
+                                         const std::vector<nextfloor::mesh::Mesh*>& meshes) const
+{
+    glm::ivec3 best_boxes_count(RoomGrid::kWidthBoxesCount, RoomGrid::kHeightBoxesCount, RoomGrid::kDepthBoxesCount);
+    if (meshes.size() == 0) {
+        return best_boxes_count;
+    }
+
+    glm::vec3 room_dimension = glm::vec3(best_boxes_count) * RoomGrid::CalculateBoxDimension(best_boxes_count);
+    float best_cost = MeasureCost(location, best_boxes_count, meshes);
+    for (auto box_side : kBoxSides) {
+        glm::ivec3 boxes_count = glm::max(glm::ivec3(room_dimension / box_side + 0.5f), glm::ivec3(1));
+        float cost = MeasureCost(location, boxes_count, meshes);
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_boxes_count = boxes_count;
+        }
+    }
+
+    return best_boxes_count;
+}
+
+/**
+ *  Meshes get back an empty placement, ready for the room grid
+ */
+float RoomGridTuner::MeasureCost(const glm::vec3& location,
+                                 const glm::ivec3& boxes_count,
+                                 const std::vector<nextfloor::mesh::Mesh*>& meshes) const
+{
+    RoomGrid grid(
+      location, boxes_count, std::make_unique<FlatGridBox[]>(boxes_count.x * boxes_count.y * boxes_count.z));
+    if (is_loose_placement_) {
+        grid.EnableLoosePlacement();
+    }
+
+    std::vector<nextfloor::mesh::Mesh*> items(0);
+    for (auto& mesh : meshes) {
+        AddItems(&grid, mesh, &items);
+    }
+
+    long long candidates_count = 0;
+    std::vector<nextfloor::mesh::Mesh*> neighbors(0);
+    for (auto& item : items) {
+        neighbors.clear();
+        grid.FindCollisionNeighborsOf(*item, &neighbors);
+        candidates_count += neighbors.size();
+    }
+    RoomGrid::OccupancyStats stats = grid.CalculateOccupancyStats();
+
+    for (auto& item : items) {
+        grid.RemoveMesh(item);
+        item->set_gridcoords(std::vector<nextfloor::mesh::GridBox*>(0));
+    }
+
+    return candidates_count + kBoxScanCost * stats.query_boxes + kPlacementCost * stats.placements;
+}
+
+/**
+ *  Same placement than the ground one: childs of a mesh without layout are placed, not the mesh itself
+ */
+void RoomGridTuner::AddItems(RoomGrid* grid,
+                             nextfloor::mesh::Mesh* mesh,
+                             std::vector<nextfloor::mesh::Mesh*>* items) const
+{
+    if (mesh->hasChilds() && !mesh->hasLayout()) {
+        for (auto& child : mesh->childs()) {
+            AddItems(grid, child, items);
+        }
+    }
+    else {
+        grid->AddItem(mesh);
+        items->push_back(mesh);
+    }
+}
+
+}  // namespace layout
+
+}  // namespace nextfloor
@@ -0,0 +1,60 @@
+/**
+ *  @file room_grid_tuner.h
+ *  @brief RoomGridTuner class header
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_GRID_ROOMGRIDTUNER_H_
+#define NEXTFLOOR_GRID_ROOMGRIDTUNER_H_
+
+#include <glm/glm.hpp>
+#include <array>
+#include <vector>
+
+#include "nextfloor/mesh/mesh.h"
+#include "nextfloor/layout/room_grid.h"
+
+namespace nextfloor {
+
+namespace layout {
+
+/**
+ *  @class RoomGridTuner
+ *  @brief Build time tuning of the room boxes: the room meshes are placed into a grid for each candidate
+ *  boxes count, then measured (one neighbors query by mesh and occupancy stats), the cheaper count is kept
+ */
+class RoomGridTuner {
+
+public:
+    explicit RoomGridTuner(bool is_loose_placement);
+    ~RoomGridTuner() = default;
+
+    RoomGridTuner(RoomGridTuner&&) = default;
+    RoomGridTuner& operator=(RoomGridTuner&&) = default;
+    RoomGridTuner(const RoomGridTuner&) = delete;
+    RoomGridTuner& operator=(const RoomGridTuner&) = delete;
+
+    /* Default boxes count if no candidate is cheaper */
+    glm::ivec3 FindBoxesCount(const glm::vec3& location, const std::vector<nextfloor::mesh::Mesh*>& meshes) const;
+
+private:
+    /* Box sides tried beyond the default one, finer boxes would overflow the grid occupancy bitmask */
+    static constexpr std::array<float, 4> kBoxSides{3.0f, 4.0f, 6.0f, 8.0f};
+
+    /* Relative costs, a neighbor candidate (eligibility test) is the unit */
+    static constexpr float kBoxScanCost = 0.25f;
+    static constexpr float kPlacementCost = 1.0f;
+
+    float MeasureCost(const glm::vec3& location,
+                      const glm::ivec3& boxes_count,
+                      const std::vector<nextfloor::mesh::Mesh*>& meshes) const;
+    void AddItems(RoomGrid* grid, nextfloor::mesh::Mesh* mesh, std::vector<nextfloor::mesh::Mesh*>* items) const;
+
+    bool is_loose_placement_{false};
+};
+
+}  // namespace layout
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_GRID_ROOMGRIDTUNER_H_
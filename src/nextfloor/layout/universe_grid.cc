@@ -20,6 +20,13 @@ UniverseGrid::UniverseGrid(const glm::vec3& location, std::unique_ptr<nextfloor:
                   std::move(boxes))
 {}
 
+UniverseGrid::UniverseGrid(const glm::vec3& location, std::unique_ptr<FlatGridBox[]> flat_boxes)
+      : WiredGrid(location,
+                  glm::ivec3(kWidthBoxesCount, kHeightBoxesCount, kDepthBoxesCount),
+                  glm::vec3(kBoxWidth, kBoxHeight, kBoxDepth),
+                  std::move(flat_boxes))
+{}
+
 UniverseGrid::~UniverseGrid() noexcept
 {
     DeleteGrid();
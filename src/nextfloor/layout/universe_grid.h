@@ -13,6 +13,7 @@
 #include <memory>
 
 #include "nextfloor/mesh/grid_box.h"
+#include "nextfloor/layout/flat_grid_box.h"
 
 namespace nextfloor {
 
@@ -36,6 +37,7 @@ public:
     static constexpr float kBoxDepth = 16.0f;
 
     UniverseGrid(const glm::vec3& location, std::unique_ptr<nextfloor::mesh::GridBox>*** boxes);
+    UniverseGrid(const glm::vec3& location, std::unique_ptr<FlatGridBox[]> flat_boxes);
     ~UniverseGrid() noexcept final;
 };
 
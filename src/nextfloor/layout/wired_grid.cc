@@ -10,10 +10,18 @@
 #include <tbb/tbb.h>
 #include <tbb/task_group.h>
 #include <vector>
+#include <algorithm>
+#include <bit>
 #include <iostream>
 #include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <utility>
 
 #include "nextfloor/mesh/mesh.h"
+#include "nextfloor/core/common_services.h"
+#include "nextfloor/layout/grid_geometry.h"
 
 namespace nextfloor {
 
@@ -81,6 +89,8 @@ bool IsNextCoordByZ(const glm::ivec3& min_coords, const glm::ivec3& max_coords,
            || (min_coords.z > max_coords.z && intermediary_coords.z >= max_coords.z);
 }
 
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
 }  // namespace
 
 WiredGrid::WiredGrid(const glm::vec3& location,
@@ -92,6 +102,22 @@ WiredGrid::WiredGrid(const glm::vec3& location,
     boxes_count_ = boxes_count;
     box_dimension_ = box_dimension;
     boxes_ = boxes;
+    is_occupancy_enabled_
+      = boxes_count_.x * boxes_count_.y * boxes_count_.z <= kMaxBoxesCount && boxes_count_.z <= kOccupancyWordBits;
+    InitBoxes();
+}
+
+WiredGrid::WiredGrid(const glm::vec3& location,
+                     const glm::ivec3& boxes_count,
+                     const glm::vec3& box_dimension,
+                     std::unique_ptr<FlatGridBox[]> flat_boxes)
+{
+    location_ = location;
+    boxes_count_ = boxes_count;
+    box_dimension_ = box_dimension;
+    flat_boxes_ = std::move(flat_boxes);
+    is_occupancy_enabled_
+      = boxes_count_.x * boxes_count_.y * boxes_count_.z <= kMaxBoxesCount && boxes_count_.z <= kOccupancyWordBits;
     InitBoxes();
 }
 
@@ -101,7 +127,11 @@ void WiredGrid::InitBoxes()
     for (auto pi = 0; pi < width_boxes_count(); pi++) {
         for (auto pj = 0; pj < height_boxes_count(); pj++) {
             for (auto pk = 0; pk < depth_boxes_count(); pk++) {
-                boxes_[pi][pj][pk]->set_owner(this);
+                glm::ivec3 coords(pi, pj, pk);
+                if (flat_boxes_ != nullptr) {
+                    flat_boxes_[CoordsToIndex(coords)].set_coords(coords);
+                }
+                getGridBox(coords)->set_owner(this);
             }
         }
     }
@@ -121,7 +151,7 @@ glm::vec3 WiredGrid::CalculateAbsoluteCoordinates(const glm::ivec3& coords) cons
 
 bool WiredGrid::IsPositionEmpty(const glm::ivec3& coords) const
 {
-    return boxes_[coords.x][coords.y][coords.z]->IsEmpty();
+    return getGridBox(coords)->IsEmpty();
 }
 
 bool WiredGrid::IsFrontPositionFilled(const glm::ivec3& coords) const
@@ -157,13 +187,214 @@ bool WiredGrid::IsTopPositionFilled(const glm::ivec3& coords) const
 bool WiredGrid::IsPositionFilled(const glm::ivec3& coords) const
 {
     assert(IsCooordsAreCorrect(coords));
-    return boxes_[coords.x][coords.y][coords.z]->IsFilled();
+    return getGridBox(coords)->IsFilled();
+}
+
+bool WiredGrid::IsOccupancySet(const glm::ivec3& coords) const
+{
+    assert(IsCooordsAreCorrect(coords));
+    return IsOccupancyInRange(CoordsToIndex(coords), 1);
+}
+
+/**
+ *  Called without grid lock: a box filled by another writer while its bit is cleared gets its bit again,
+ *  so a filled box never keeps a cleared bit
+ */
+void WiredGrid::UpdateOccupancy(const glm::ivec3& coords)
+{
+    if (!is_occupancy_enabled_) {
+        return;
+    }
+
+    int index = CoordsToIndex(coords);
+    auto& word = occupancy_[index / kOccupancyWordBits];
+    uint64_t bit = uint64_t{1} << (index % kOccupancyWordBits);
+    if (getGridBox(coords)->IsFilled()) {
+        word.fetch_or(bit);
+    }
+    else {
+        word.fetch_and(~bit);
+        if (getGridBox(coords)->IsFilled()) {
+            word.fetch_or(bit);
+        }
+    }
+
+    UpdateParentOccupancy();
+}
+
+/**
+ *  Same scheme than box bits: a grid filled by another writer while its parent bit is cleared sets it again.
+ *  Parent bit is read first, its word is shared by all child grids
+ */
+void WiredGrid::UpdateParentOccupancy()
+{
+    if (parent_grid_ == nullptr) {
+        return;
+    }
+
+    if (!IsGridEmpty()) {
+        if (!parent_grid_->IsChildGridOccupied(location_)) {
+            parent_grid_->SetChildGridOccupancy(location_, true);
+        }
+        return;
+    }
+
+    parent_grid_->SetChildGridOccupancy(location_, false);
+    if (!IsGridEmpty()) {
+        parent_grid_->SetChildGridOccupancy(location_, true);
+    }
+}
+
+void WiredGrid::set_parent_grid(nextfloor::playground::Grid* parent_grid)
+{
+    parent_grid_ = parent_grid;
+    if (parent_grid_ != nullptr) {
+        parent_grid_->SetChildGridOccupancy(location_, !IsGridEmpty());
+    }
+}
+
+/**
+ *  Out of the grid child locations have no bit to set
+ */
+void WiredGrid::SetChildGridOccupancy(const glm::vec3& child_location, bool is_occupied)
+{
+    glm::ivec3 coords = PointToFloorCoords(child_location);
+    if (!is_occupancy_enabled_ || !IsCooordsAreCorrect(coords)) {
+        return;
+    }
+
+    int index = CoordsToIndex(coords);
+    auto& word = child_occupancy_[index / kOccupancyWordBits];
+    uint64_t bit = uint64_t{1} << (index % kOccupancyWordBits);
+    if (is_occupied) {
+        word.fetch_or(bit);
+    }
+    else {
+        word.fetch_and(~bit);
+    }
+}
+
+/**
+ *  Child grids without bit (mask disabled or out of the grid) are occupied
+ */
+bool WiredGrid::IsChildGridOccupied(const glm::vec3& child_location) const
+{
+    glm::ivec3 coords = PointToFloorCoords(child_location);
+    if (!is_occupancy_enabled_ || !IsCooordsAreCorrect(coords)) {
+        return true;
+    }
+
+    int index = CoordsToIndex(coords);
+    uint64_t bit = uint64_t{1} << (index % kOccupancyWordBits);
+    return (child_occupancy_[index / kOccupancyWordBits].load(std::memory_order_relaxed) & bit) != 0;
+}
+
+bool WiredGrid::IsOccupancyInRange(int first_index, int indexes_count) const
+{
+    return OccupancyBitsInRange(first_index, indexes_count) != 0;
+}
+
+/**
+ *  A range is at most one z column of boxes, so it is spread over two words at most
+ */
+uint64_t WiredGrid::OccupancyBitsInRange(int first_index, int indexes_count) const
+{
+    assert(indexes_count > 0 && indexes_count <= kOccupancyWordBits);
+
+    if (!is_occupancy_enabled_) {
+        return indexes_count < kOccupancyWordBits ? (uint64_t{1} << indexes_count) - 1 : ~uint64_t{0};
+    }
+
+    int word = first_index / kOccupancyWordBits;
+    int first_bit = first_index % kOccupancyWordBits;
+    uint64_t bits = occupancy_[word].load(std::memory_order_relaxed) >> first_bit;
+    if (first_bit + indexes_count > kOccupancyWordBits) {
+        bits |= occupancy_[word + 1].load(std::memory_order_relaxed) << (kOccupancyWordBits - first_bit);
+    }
+
+    if (indexes_count < kOccupancyWordBits) {
+        bits &= (uint64_t{1} << indexes_count) - 1;
+    }
+
+    return bits;
+}
+
+/**
+ *  One bit by box of the stencil, z rows are read at once from the occupancy words
+ */
+uint32_t WiredGrid::StencilOccupancy(const glm::ivec3& first_coords, const glm::ivec3& last_coords) const
+{
+    uint32_t stencil_bits = 0;
+    int row_length = last_coords.z - first_coords.z + 1;
+    for (auto x = first_coords.x; x <= last_coords.x; x++) {
+        for (auto y = first_coords.y; y <= last_coords.y; y++) {
+            int first_index = CoordsToIndex(glm::ivec3(x, y, first_coords.z));
+            int row = (x - first_coords.x) * kStencilSide + y - first_coords.y;
+            stencil_bits |= OccupancyBitsInRange(first_index, row_length) << (row * kStencilSide);
+        }
+    }
+
+    return stencil_bits;
+}
+
+/**
+ *  Coords out of the grid are ignored
+ */
+bool WiredGrid::IsRegionEmpty(const glm::ivec3& min_coords, const glm::ivec3& max_coords) const
+{
+    glm::ivec3 first_coords = glm::max(min_coords, glm::ivec3(0));
+    glm::ivec3 last_coords = glm::min(max_coords, boxes_count_ - 1);
+    if (first_coords.x > last_coords.x || first_coords.y > last_coords.y || first_coords.z > last_coords.z) {
+        return true;
+    }
+
+    for (auto x = first_coords.x; x <= last_coords.x; x++) {
+        for (auto y = first_coords.y; y <= last_coords.y; y++) {
+            int first_index = CoordsToIndex(glm::ivec3(x, y, first_coords.z));
+            if (IsOccupancyInRange(first_index, last_coords.z - first_coords.z + 1)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool WiredGrid::IsGridEmpty() const
+{
+    if (!is_occupancy_enabled_) {
+        return false;
+    }
+
+    for (auto& word : occupancy_) {
+        if (word.load(std::memory_order_relaxed) != 0) {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 
 std::vector<nextfloor::mesh::Mesh*> WiredGrid::FindCollisionNeighbors(const glm::vec3& coords) const
 {
-    std::vector<nextfloor::mesh::Mesh*> neighbors = FindOccupants(coords);
+    /* Reference version covers only overlap placement */
+    if (is_loose_placement_) {
+        std::vector<nextfloor::mesh::Mesh*> neighbors(0);
+        FindCollisionNeighbors(coords, &neighbors);
+        return neighbors;
+    }
+
+    /* Empty space around the coords is rejected with the occupancy bits only */
+    glm::ivec3 center_coords(coords);
+    if (IsGridEmpty() || IsRegionEmpty(center_coords - 1, center_coords + 1)) {
+        return std::vector<nextfloor::mesh::Mesh*>(0);
+    }
+
+    std::vector<nextfloor::mesh::Mesh*> neighbors(0);
+    if (IsCooordsAreCorrect(center_coords) && IsOccupancySet(center_coords)) {
+        neighbors = FindOccupants(coords);
+    }
     tbb::task_group tasks;
     std::vector<nextfloor::mesh::Mesh*> front_neighbors, right_neighbors;
     std::vector<nextfloor::mesh::Mesh*> back_neighbors, left_neighbors;
@@ -189,6 +420,267 @@ std::vector<nextfloor::mesh::Mesh*> WiredGrid::FindCollisionNeighbors(const glm:
     return neighbors;
 }
 
+/**
+ *  Single pass over the 3x3x3 block clamped into the grid: the stencil bits select the filled boxes,
+ *  then a mesh spread over several boxes is appended only once
+ */
+void WiredGrid::FindCollisionNeighbors(const glm::vec3& coords, std::vector<nextfloor::mesh::Mesh*>* neighbors) const
+{
+    glm::ivec3 center_coords(coords);
+    if (is_loose_placement_) {
+        glm::ivec3 margins = loose_margins() + 1;
+        AddOccupantsInRange(center_coords - margins, center_coords + margins, neighbors);
+        return;
+    }
+
+    glm::ivec3 first_coords = glm::max(center_coords - 1, glm::ivec3(0));
+    glm::ivec3 last_coords = glm::min(center_coords + 1, boxes_count_ - 1);
+    if (first_coords.x > last_coords.x || first_coords.y > last_coords.y || first_coords.z > last_coords.z) {
+        return;
+    }
+
+    uint32_t stencil_bits = StencilOccupancy(first_coords, last_coords);
+    MeshMarks* marks = MeshMarks::GetClearedMarks();
+    while (stencil_bits != 0) {
+        int bit = std::countr_zero(stencil_bits);
+        stencil_bits &= stencil_bits - 1;
+
+        glm::ivec3 box_coords = first_coords
+                                + glm::ivec3(bit / (kStencilSide * kStencilSide),
+                                             (bit / kStencilSide) % kStencilSide,
+                                             bit % kStencilSide);
+        AddNewOccupantsOfBox(box_coords, marks, neighbors);
+    }
+}
+
+/**
+ *  Boxes scanned are counted as the query fan-out
+ */
+void WiredGrid::FindCollisionNeighborsOf(const nextfloor::mesh::Mesh& target,
+                                         std::vector<nextfloor::mesh::Mesh*>* neighbors) const
+{
+    glm::ivec3 min_coords, max_coords;
+    if (!CalculateNeighborsRange(target, &min_coords, &max_coords)) {
+        return;
+    }
+
+    int boxes_count = AddOccupantsInRange(min_coords, max_coords, neighbors);
+
+    using nextfloor::core::CommonServices;
+    CommonServices::getCollisionStats()->AddGridQuery(boxes_count);
+}
+
+/**
+ *  Target boxes range is enlarged by one box, and in loose placement by the target and larger meshes margins.
+ *  Returns false for a target without placement
+ */
+bool WiredGrid::CalculateNeighborsRange(const nextfloor::mesh::Mesh& target,
+                                        glm::ivec3* min_coords,
+                                        glm::ivec3* max_coords) const
+{
+    const auto& boxes = target.gridcoords();
+    if (boxes.size() == 0) {
+        return false;
+    }
+
+    *min_coords = glm::ivec3(boxes.front()->coords());
+    *max_coords = *min_coords;
+    for (auto& box : boxes) {
+        *min_coords = glm::min(*min_coords, glm::ivec3(box->coords()));
+        *max_coords = glm::max(*max_coords, glm::ivec3(box->coords()));
+    }
+
+    glm::ivec3 margins(1);
+    if (is_loose_placement_) {
+        margins += CalculateLooseMargins(target) + loose_margins();
+    }
+    *min_coords -= margins;
+    *max_coords += margins;
+    return true;
+}
+
+/**
+ *  Boxes out of the grid are clamped away: a region far from the grid has no neighbors
+ */
+void WiredGrid::FindCollisionNeighbors(const glm::vec3& min_point,
+                                       const glm::vec3& max_point,
+                                       std::vector<nextfloor::mesh::Mesh*>* neighbors) const
+{
+    glm::ivec3 margins(1);
+    if (is_loose_placement_) {
+        margins += loose_margins();
+    }
+    AddOccupantsInRange(PointToFloorCoords(min_point) - margins, PointToFloorCoords(max_point) + margins, neighbors);
+}
+
+/**
+ *  Meshes crossing the grid sides (loose ones by their center) are placed into its border boxes,
+ *  so the region is clamped into the grid before the loose margins
+ */
+void WiredGrid::QueryBox(const glm::vec3& min_point,
+                         const glm::vec3& max_point,
+                         std::vector<nextfloor::mesh::Mesh*>* meshes) const
+{
+    glm::ivec3 min_coords = glm::clamp(PointToFloorCoords(min_point), glm::ivec3(0), boxes_count_ - 1);
+    glm::ivec3 max_coords = glm::clamp(PointToFloorCoords(max_point), glm::ivec3(0), boxes_count_ - 1);
+    if (is_loose_placement_) {
+        min_coords -= loose_margins();
+        max_coords += loose_margins();
+    }
+
+    int first_mesh = meshes->size();
+    AddOccupantsInRange(min_coords, max_coords, meshes);
+    KeepMeshesInBox(first_mesh, min_point, max_point, meshes);
+}
+
+void WiredGrid::QuerySphere(const glm::vec3& center, float radius, std::vector<nextfloor::mesh::Mesh*>* meshes) const
+{
+    int first_mesh = meshes->size();
+    QueryBox(center - radius, center + radius, meshes);
+    KeepMeshesInSphere(first_mesh, center, radius, meshes);
+}
+
+void WiredGrid::QueryKNearest(const glm::vec3& point, int k, std::vector<nextfloor::mesh::Mesh*>* meshes) const
+{
+    if (k <= 0 || IsGridEmpty()) {
+        return;
+    }
+
+    glm::ivec3 center_coords = glm::clamp(PointToFloorCoords(point), glm::ivec3(0), boxes_count_ - 1);
+    glm::ivec3 last_rings = glm::max(center_coords, boxes_count_ - 1 - center_coords);
+    int last_ring = std::max(last_rings.x, std::max(last_rings.y, last_rings.z));
+
+    std::vector<nextfloor::mesh::Mesh*> candidates(0);
+    std::vector<float> squared_distances(0);
+    MeshMarks* marks = MeshMarks::GetClearedMarks();
+    for (auto ring = 0; ring <= last_ring; ring++) {
+        AddOccupantsOfRing(center_coords, ring, marks, &candidates);
+        for (auto cnt = squared_distances.size(); cnt < candidates.size(); cnt++) {
+            squared_distances.push_back(ComputeMeshSquaredDistance(point, *candidates[cnt]));
+        }
+
+        float clearance = CalculateRingClearance(point, center_coords, ring);
+        if (HasKNearestWithin(squared_distances, k, clearance * clearance)) {
+            break;
+        }
+    }
+
+    AddKNearestMeshes(candidates, squared_distances, k, meshes);
+}
+
+/**
+ *  Boxes at chebyshev distance ring from center box, clamped into the grid.
+ *  Meshes already found into previous rings are not appended again
+ */
+void WiredGrid::AddOccupantsOfRing(const glm::ivec3& center_coords,
+                                   int ring,
+                                   MeshMarks* marks,
+                                   std::vector<nextfloor::mesh::Mesh*>* neighbors) const
+{
+    glm::ivec3 first_coords = glm::max(center_coords - ring, glm::ivec3(0));
+    glm::ivec3 last_coords = glm::min(center_coords + ring, boxes_count_ - 1);
+    for (auto x = first_coords.x; x <= last_coords.x; x++) {
+        for (auto y = first_coords.y; y <= last_coords.y; y++) {
+            /* Inside the ring on x and y, only both z ends are on the ring */
+            bool is_ring_row = std::abs(x - center_coords.x) == ring || std::abs(y - center_coords.y) == ring;
+            int z_step = is_ring_row ? 1 : 2 * ring;
+            for (auto z = center_coords.z - ring; z <= center_coords.z + ring; z += z_step) {
+                glm::ivec3 box_coords(x, y, z);
+                if (!IsCooordsAreCorrect(box_coords) || !IsOccupancySet(box_coords)) {
+                    continue;
+                }
+
+                if (is_loose_placement_) {
+                    getGridBox(box_coords)->AddOccupantsTo(neighbors);
+                }
+                else {
+                    AddNewOccupantsOfBox(box_coords, marks, neighbors);
+                }
+            }
+        }
+    }
+}
+
+/**
+ *  Distance from point under which no mesh can be out of the rings walked (loose ones can overflow by their margins).
+ *  Ring sides on the grid limits bound nothing: meshes crossing them are placed into the border boxes
+ */
+float WiredGrid::CalculateRingClearance(const glm::vec3& point, const glm::ivec3& center_coords, int ring) const
+{
+    glm::vec3 grid0 = CalculateFirstPointInGrid();
+    glm::ivec3 margins = is_loose_placement_ ? loose_margins() : glm::ivec3(0);
+
+    float clearance = kInfinity;
+    for (auto axis = 0; axis < 3; axis++) {
+        if (center_coords[axis] - ring > 0) {
+            float ring_side = grid0[axis] + (center_coords[axis] - ring + margins[axis]) * box_dimension_[axis];
+            clearance = std::min(clearance, point[axis] - ring_side);
+        }
+        if (center_coords[axis] + ring < boxes_count_[axis] - 1) {
+            float ring_side = grid0[axis] + (center_coords[axis] + ring + 1 - margins[axis]) * box_dimension_[axis];
+            clearance = std::min(clearance, ring_side - point[axis]);
+        }
+    }
+
+    return std::max(clearance, 0.0f);
+}
+
+/**
+ *  Range is clamped into the grid, z rows of occupancy bits select the filled boxes.
+ *  A mesh is into one box in loose placement, so the dedup is only needed for overlap placement.
+ *  Returns the count of boxes into the clamped range
+ */
+int WiredGrid::AddOccupantsInRange(const glm::ivec3& min_coords,
+                                   const glm::ivec3& max_coords,
+                                   std::vector<nextfloor::mesh::Mesh*>* neighbors) const
+{
+    glm::ivec3 first_coords = glm::max(min_coords, glm::ivec3(0));
+    glm::ivec3 last_coords = glm::min(max_coords, boxes_count_ - 1);
+    if (first_coords.x > last_coords.x || first_coords.y > last_coords.y || first_coords.z > last_coords.z) {
+        return 0;
+    }
+
+    MeshMarks* marks = is_loose_placement_ ? nullptr : MeshMarks::GetClearedMarks();
+    int row_length = last_coords.z - first_coords.z + 1;
+    for (auto x = first_coords.x; x <= last_coords.x; x++) {
+        for (auto y = first_coords.y; y <= last_coords.y; y++) {
+            uint64_t row_bits = OccupancyBitsInRange(CoordsToIndex(glm::ivec3(x, y, first_coords.z)), row_length);
+            while (row_bits != 0) {
+                glm::ivec3 box_coords(x, y, first_coords.z + std::countr_zero(row_bits));
+                row_bits &= row_bits - 1;
+
+                if (is_loose_placement_) {
+                    getGridBox(box_coords)->AddOccupantsTo(neighbors);
+                }
+                else {
+                    AddNewOccupantsOfBox(box_coords, marks, neighbors);
+                }
+            }
+        }
+    }
+
+    return CountBoxesInRange(first_coords, last_coords);
+}
+
+int WiredGrid::CountBoxesInRange(const glm::ivec3& min_coords, const glm::ivec3& max_coords) const
+{
+    glm::ivec3 range_length = glm::min(max_coords, boxes_count_ - 1) - glm::max(min_coords, glm::ivec3(0)) + 1;
+    range_length = glm::max(range_length, glm::ivec3(0));
+    return range_length.x * range_length.y * range_length.z;
+}
+
+/**
+ *  Keeps only occupants not yet marked by previous boxes of the query
+ */
+void WiredGrid::AddNewOccupantsOfBox(const glm::ivec3& coords,
+                                     MeshMarks* marks,
+                                     std::vector<nextfloor::mesh::Mesh*>* neighbors) const
+{
+    int first_occupant = neighbors->size();
+    getGridBox(coords)->AddOccupantsTo(neighbors);
+    KeepUnmarkedMeshes(first_occupant, marks, neighbors);
+}
+
 std::vector<nextfloor::mesh::Mesh*> WiredGrid::FindFrontPositionCollisionNeighbors(const glm::vec3& coords) const
 {
     std::vector<nextfloor::mesh::Mesh*> neighbors(0);
@@ -555,7 +1047,119 @@ std::vector<nextfloor::mesh::Mesh*> WiredGrid::FindTopPositionCollisionNeighbors
 
 std::vector<nextfloor::mesh::Mesh*> WiredGrid::FindOccupants(const glm::ivec3& coords) const
 {
-    return boxes_[coords.x][coords.y][coords.z]->occupants();
+    return getGridBox(coords)->occupants();
+}
+
+WiredGrid::RayHit WiredGrid::SegmentCast(const glm::vec3& start_point,
+                                         const glm::vec3& end_point,
+                                         const MeshFilter& filter) const
+{
+    glm::vec3 segment = end_point - start_point;
+    return RayCast(start_point, segment, glm::length(segment), filter);
+}
+
+WiredGrid::RayHit WiredGrid::RayCast(const glm::vec3& origin,
+                                     const glm::vec3& direction,
+                                     float max_distance,
+                                     const MeshFilter& filter) const
+{
+    RayHit nearer_hit{nullptr, max_distance};
+    if (direction == glm::vec3(0.0f) || IsGridEmpty()) {
+        return nearer_hit;
+    }
+
+    glm::vec3 unit_direction = glm::normalize(direction);
+    glm::vec3 grid0 = CalculateFirstPointInGrid();
+    glm::vec3 boxes_dimension = glm::vec3(boxes_count_) * box_dimension_;
+
+    /* Ray is clipped to the grid */
+    glm::vec2 grid_distances = ComputeRayBoxDistances(origin, unit_direction, grid0, grid0 + boxes_dimension);
+    float distance = std::max(grid_distances.x, 0.0f);
+    float last_distance = std::min(grid_distances.y, max_distance);
+    if (distance > last_distance) {
+        return nearer_hit;
+    }
+
+    glm::ivec3 coords = glm::clamp(PointToCoords(origin + distance * unit_direction), glm::ivec3(0), boxes_count_ - 1);
+
+    /* Distance to the next box side (max) and between 2 box sides (delta), on each axis */
+    glm::ivec3 step(0);
+    glm::vec3 max_distances(kInfinity);
+    glm::vec3 delta_distances(kInfinity);
+    for (auto axis = 0; axis < 3; axis++) {
+        if (unit_direction[axis] == 0.0f) {
+            continue;
+        }
+
+        step[axis] = unit_direction[axis] > 0.0f ? 1 : -1;
+        float next_side = grid0[axis] + (coords[axis] + (step[axis] > 0 ? 1 : 0)) * box_dimension_[axis];
+        max_distances[axis] = (next_side - origin[axis]) / unit_direction[axis];
+        delta_distances[axis] = box_dimension_[axis] / std::abs(unit_direction[axis]);
+    }
+
+    /* In loose placement, meshes crossing a box can be into the boxes around it */
+    glm::ivec3 margins = is_loose_placement_ ? loose_margins() : glm::ivec3(0);
+    std::vector<nextfloor::mesh::Mesh*> occupants(0);
+    while (IsCooordsAreCorrect(coords) && distance <= last_distance) {
+        occupants.clear();
+        AddOccupantsInRange(coords - margins, coords + margins, &occupants);
+        if (occupants.size() != 0) {
+            FindNearerOccupantOnRay(occupants,
+                                    origin,
+                                    unit_direction,
+                                    glm::vec2(std::max(grid_distances.x, 0.0f), last_distance),
+                                    filter,
+                                    &nearer_hit);
+        }
+
+        /* A mesh can overlap further boxes: the hit is final only if it is inside the current box */
+        auto axis = 0;
+        if (max_distances.y < max_distances[axis]) {
+            axis = 1;
+        }
+        if (max_distances.z < max_distances[axis]) {
+            axis = 2;
+        }
+        if (nearer_hit.mesh != nullptr && nearer_hit.distance <= max_distances[axis]) {
+            break;
+        }
+
+        distance = max_distances[axis];
+        max_distances[axis] += delta_distances[axis];
+        coords[axis] += step[axis];
+    }
+
+    return nearer_hit;
+}
+
+void WiredGrid::FindNearerOccupantOnRay(const std::vector<nextfloor::mesh::Mesh*>& occupants,
+                                        const glm::vec3& origin,
+                                        const glm::vec3& direction,
+                                        const glm::vec2& ray_distances,
+                                        const MeshFilter& filter,
+                                        RayHit* nearer_hit) const
+{
+    for (auto& occupant : occupants) {
+        if (filter && !filter(*occupant)) {
+            continue;
+        }
+
+        /* Same padded box than the one used for the grid placement */
+        glm::vec3 first_point = occupant->border()->getFirstPoint();
+        glm::vec3 last_point = occupant->border()->getLastPoint();
+        glm::vec2 distances = ComputeRayBoxDistances(origin,
+                                                     direction,
+                                                     glm::min(first_point, last_point),
+                                                     glm::max(first_point, last_point));
+        /* Only the ray part inside the grid is tested */
+        float hit_distance = std::max(distances.x, ray_distances.x);
+        if (hit_distance <= std::min(distances.y, ray_distances.y) && hit_distance <= nearer_hit->distance) {
+            if (nearer_hit->mesh == nullptr || hit_distance < nearer_hit->distance
+                || occupant->id() < nearer_hit->mesh->id()) {
+                *nearer_hit = RayHit{occupant, hit_distance};
+            }
+        }
+    }
 }
 
 void WiredGrid::AddItem(nextfloor::mesh::Mesh* object)
@@ -567,6 +1171,16 @@ void WiredGrid::ParseGridForObjectPlacements(nextfloor::mesh::Mesh* object)
 {
     std::vector<nextfloor::mesh::GridBox*> coords_list;
 
+    if (is_loose_placement_) {
+        GrowLooseMargins(*object);
+
+        glm::ivec3 center_coords, max_coords;
+        CalculatePlacementRange(*object, &center_coords, &max_coords);
+        coords_list.push_back(AddItemToGrid(center_coords, object));
+        object->set_gridcoords(coords_list);
+        return;
+    }
+
     auto border = object->border();
 
     auto min_coords = PointToCoords(border->getFirstPoint());
@@ -594,6 +1208,134 @@ void WiredGrid::ParseGridForObjectPlacements(nextfloor::mesh::Mesh* object)
     object->set_gridcoords(coords_list);
 }
 
+/**
+ *  Most moves stay into the same boxes: the placement range is compared first, then only the boxes
+ *  at the borders of the old and new ranges are changed
+ */
+void WiredGrid::UpdateItem(nextfloor::mesh::Mesh* object)
+{
+    if (is_loose_placement_) {
+        GrowLooseMargins(*object);
+    }
+
+    glm::ivec3 min_coords, max_coords;
+    CalculatePlacementRange(*object, &min_coords, &max_coords);
+
+    /* No former placement, or new range empty (out of the grid): full remove and add */
+    glm::ivec3 old_min_coords, old_max_coords;
+    if (!FindPlacementRange(*object, &old_min_coords, &old_max_coords)
+        || glm::any(glm::greaterThan(min_coords, max_coords))) {
+        RemoveMesh(object);
+        AddItem(object);
+        return;
+    }
+
+    if (min_coords == old_min_coords && max_coords == old_max_coords) {
+        return;
+    }
+
+    for (auto x = old_min_coords.x; x <= old_max_coords.x; x++) {
+        for (auto y = old_min_coords.y; y <= old_max_coords.y; y++) {
+            for (auto z = old_min_coords.z; z <= old_max_coords.z; z++) {
+                if (!IsCoordsInRange(glm::ivec3(x, y, z), min_coords, max_coords)) {
+                    RemoveItemToBox(glm::ivec3(x, y, z), object);
+                }
+            }
+        }
+    }
+
+    std::vector<nextfloor::mesh::GridBox*> coords_list;
+    glm::ivec3 range_length = max_coords - min_coords + 1;
+    coords_list.reserve(range_length.x * range_length.y * range_length.z);
+    for (auto x = min_coords.x; x <= max_coords.x; x++) {
+        for (auto y = min_coords.y; y <= max_coords.y; y++) {
+            for (auto z = min_coords.z; z <= max_coords.z; z++) {
+                glm::ivec3 coords(x, y, z);
+                if (IsCoordsInRange(coords, old_min_coords, old_max_coords)) {
+                    coords_list.push_back(getGridBox(coords));
+                }
+                else {
+                    coords_list.push_back(AddItemToGrid(coords, object));
+                }
+            }
+        }
+    }
+
+    object->set_gridcoords(coords_list);
+}
+
+/**
+ *  Boxes of a placement are listed by ordered coords, so first and last ones bound the range.
+ *  Returns false if the list is not a full range anymore (boxes removed out of the grid)
+ */
+bool WiredGrid::FindPlacementRange(const nextfloor::mesh::Mesh& object,
+                                   glm::ivec3* min_coords,
+                                   glm::ivec3* max_coords) const
+{
+    const auto& boxes = object.gridcoords();
+    if (boxes.size() == 0) {
+        return false;
+    }
+
+    glm::ivec3 first_coords(boxes.front()->coords());
+    glm::ivec3 last_coords(boxes.back()->coords());
+    *min_coords = glm::min(first_coords, last_coords);
+    *max_coords = glm::max(first_coords, last_coords);
+
+    glm::ivec3 range_length = *max_coords - *min_coords + 1;
+    return range_length.x * range_length.y * range_length.z == (int)boxes.size();
+}
+
+/**
+ *  Clamped into the grid. In loose placement, the range is the only box of the mesh center
+ */
+void WiredGrid::CalculatePlacementRange(const nextfloor::mesh::Mesh& object,
+                                        glm::ivec3* min_coords,
+                                        glm::ivec3* max_coords) const
+{
+    auto border = object.border();
+    if (is_loose_placement_) {
+        glm::vec3 center = (border->getFirstPoint() + border->getLastPoint()) / 2.0f;
+        *min_coords = glm::clamp(PointToCoords(center), glm::ivec3(0), boxes_count_ - 1);
+        *max_coords = *min_coords;
+        return;
+    }
+
+    auto first_coords = PointToCoords(border->getFirstPoint());
+    auto last_coords = PointToCoords(border->getLastPoint());
+    *min_coords = glm::max(glm::min(first_coords, last_coords), glm::ivec3(0));
+    *max_coords = glm::min(glm::max(first_coords, last_coords), boxes_count_ - 1);
+}
+
+/**
+ *  Boxes count on each axis that a mesh can overlap beyond the box of its center
+ */
+glm::ivec3 WiredGrid::CalculateLooseMargins(const nextfloor::mesh::Mesh& object) const
+{
+    auto border = object.border();
+    glm::vec3 half_dimension = glm::abs(border->getLastPoint() - border->getFirstPoint()) / 2.0f;
+    return glm::ivec3(glm::ceil(half_dimension / box_dimension_));
+}
+
+void WiredGrid::GrowLooseMargins(const nextfloor::mesh::Mesh& object)
+{
+    glm::ivec3 margins = CalculateLooseMargins(object);
+    for (auto axis = 0; axis < 3; axis++) {
+        int margin = loose_margins_[axis].load(std::memory_order_relaxed);
+        while (margin < margins[axis]
+               && !loose_margins_[axis].compare_exchange_weak(margin, margins[axis], std::memory_order_relaxed)) {
+            /* Failed exchange has reloaded the current margin */
+        }
+    }
+}
+
+glm::ivec3 WiredGrid::loose_margins() const
+{
+    return glm::ivec3(loose_margins_[0].load(std::memory_order_relaxed),
+                      loose_margins_[1].load(std::memory_order_relaxed),
+                      loose_margins_[2].load(std::memory_order_relaxed));
+}
+
 float WiredGrid::min_box_side_dimension() const
 {
     float min_dimension = box_width();
@@ -619,15 +1361,22 @@ glm::ivec3 WiredGrid::PointToCoords(const glm::vec3& point) const
       static_cast<int>(trunc(coords.x)), static_cast<int>(trunc(coords.y)), static_cast<int>(trunc(coords.z)));
 }
 
+/**
+ *  Floor and not trunc: points can be before the grid first point
+ */
+glm::ivec3 WiredGrid::PointToFloorCoords(const glm::vec3& point) const
+{
+    return glm::ivec3(glm::floor((point - CalculateFirstPointInGrid()) / box_dimension_));
+}
+
 nextfloor::mesh::GridBox* WiredGrid::AddItemToGrid(const glm::ivec3& coords, nextfloor::mesh::Mesh* object)
 {
     assert(IsCooordsAreCorrect(coords));
 
-    lock();
-    boxes_[coords.x][coords.y][coords.z]->add(object);
-    unlock();
+    getGridBox(coords)->add(object);
+    UpdateOccupancy(coords);
 
-    return boxes_[coords.x][coords.y][coords.z].get();
+    return getGridBox(coords);
 }
 
 bool WiredGrid::IsCooordsAreCorrect(const glm::ivec3& coords) const
@@ -656,8 +1405,14 @@ void WiredGrid::RemoveMesh(nextfloor::mesh::Mesh* object)
 
 void WiredGrid::RemoveItemToGrid(const glm::ivec3& coords, nextfloor::mesh::Mesh* object)
 {
-    object->delete_gridcoord(boxes_[coords.x][coords.y][coords.z].get());
-    boxes_[coords.x][coords.y][coords.z]->remove(object);
+    object->delete_gridcoord(getGridBox(coords));
+    RemoveItemToBox(coords, object);
+}
+
+void WiredGrid::RemoveItemToBox(const glm::ivec3& coords, nextfloor::mesh::Mesh* object)
+{
+    getGridBox(coords)->remove(object);
+    UpdateOccupancy(coords);
 }
 
 void WiredGrid::DisplayGrid() const
@@ -670,10 +1425,10 @@ void WiredGrid::DisplayGrid() const
         for (auto z = 0; z < depth_boxes_count(); z++) {
             for (auto x = 0; x < width_boxes_count(); x++) {
                 std::cout << "  ";
-                if (boxes_[x][y][z]->size() < 10) {
+                if (getGridBox(glm::ivec3(x, y, z))->size() < 10) {
                     std::cout << "0";
                 }
-                std::cout << boxes_[x][y][z]->size();
+                std::cout << getGridBox(glm::ivec3(x, y, z))->size();
             }
 
             std::cout << std::endl;
@@ -682,6 +1437,40 @@ void WiredGrid::DisplayGrid() const
     }
 }
 
+/**
+ *  Walks all boxes: must be called outside of a parallel section
+ */
+WiredGrid::OccupancyStats WiredGrid::CalculateOccupancyStats() const
+{
+    OccupancyStats stats{{0}, 0, 0, 0, 0, 0};
+    std::vector<nextfloor::mesh::Mesh*> objects(0);
+    for (auto x = 0; x < width_boxes_count(); x++) {
+        for (auto y = 0; y < height_boxes_count(); y++) {
+            for (auto z = 0; z < depth_boxes_count(); z++) {
+                auto box = getGridBox(glm::ivec3(x, y, z));
+                int load = box->size();
+                stats.load_histogram[std::min(load, kLoadHistogramSize - 1)]++;
+                stats.max_load = std::max(stats.max_load, (long long)load);
+                stats.placements += load;
+                box->AddOccupantsTo(&objects);
+            }
+        }
+    }
+    stats.cells_count = boxes_count_.x * boxes_count_.y * boxes_count_.z;
+
+    sort(objects.begin(), objects.end());
+    objects.erase(unique(objects.begin(), objects.end()), objects.end());
+    stats.objects_count = objects.size();
+    for (auto& object : objects) {
+        glm::ivec3 min_coords, max_coords;
+        if (CalculateNeighborsRange(*object, &min_coords, &max_coords)) {
+            stats.query_boxes += CountBoxesInRange(min_coords, max_coords);
+        }
+    }
+
+    return stats;
+}
+
 glm::vec3 WiredGrid::CalculateFrontSideLocation() const
 {
     auto grid0 = CalculateFirstPointInGrid();
@@ -766,10 +1555,19 @@ void WiredGrid::ResetGrid()
     for (auto pi = 0; pi < width_boxes_count(); pi++) {
         for (auto pj = 0; pj < height_boxes_count(); pj++) {
             for (auto pk = 0; pk < depth_boxes_count(); pk++) {
-                boxes_[pi][pj][pk]->clear();
+                getGridBox(glm::ivec3(pi, pj, pk))->clear();
             }
         }
     }
+
+    for (auto& word : occupancy_) {
+        word.store(0, std::memory_order_relaxed);
+    }
+    UpdateParentOccupancy();
+
+    for (auto& margin : loose_margins_) {
+        margin.store(0, std::memory_order_relaxed);
+    }
     unlock();
 }
 
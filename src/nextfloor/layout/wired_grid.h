@@ -10,12 +10,17 @@
 #include "nextfloor/playground/grid.h"
 
 #include <glm/glm.hpp>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <vector>
 
 #include "nextfloor/mesh/mesh.h"
 #include "nextfloor/mesh/grid_box.h"
+#include "nextfloor/layout/flat_grid_box.h"
+#include "nextfloor/layout/grid_geometry.h"
 
 namespace nextfloor {
 
@@ -39,18 +44,63 @@ public:
     bool IsTopPositionFilled(const glm::ivec3& coords) const final;
     bool IsPositionFilled(const glm::ivec3& coords) const final;
 
+    /* Reference version: one task by direction, kept to check the stencil query below */
     std::vector<nextfloor::mesh::Mesh*> FindCollisionNeighbors(const glm::vec3& coord) const final;
 
+    /* Stencil query: appends the occupants of the 3x3x3 boxes around coord, no allocation beyond the buffer */
+    void FindCollisionNeighbors(const glm::vec3& coord, std::vector<nextfloor::mesh::Mesh*>* neighbors) const final;
+
+    /* Appends once each occupant of the boxes around the target placement */
+    void FindCollisionNeighborsOf(const nextfloor::mesh::Mesh& target,
+                                  std::vector<nextfloor::mesh::Mesh*>* neighbors) const final;
+
+    /* Appends once each occupant of the boxes around the region, the region can be partly out of the grid */
+    void FindCollisionNeighbors(const glm::vec3& min_point,
+                                const glm::vec3& max_point,
+                                std::vector<nextfloor::mesh::Mesh*>* neighbors) const final;
+
+    void QueryBox(const glm::vec3& min_point,
+                  const glm::vec3& max_point,
+                  std::vector<nextfloor::mesh::Mesh*>* meshes) const final;
+    void QuerySphere(const glm::vec3& center, float radius, std::vector<nextfloor::mesh::Mesh*>* meshes) const final;
+
+    /* Ring expansion: boxes around the point box are walked by growing rings, until k meshes are found nearer */
+    void QueryKNearest(const glm::vec3& point, int k, std::vector<nextfloor::mesh::Mesh*>* meshes) const final;
+
+    /* 3D DDA (Amanatides-Woo) walk, only occupants of crossed boxes are tested, stops at the first hit */
+    RayHit RayCast(const glm::vec3& origin,
+                   const glm::vec3& direction,
+                   float max_distance,
+                   const MeshFilter& filter) const final;
+    RayHit SegmentCast(const glm::vec3& start_point, const glm::vec3& end_point, const MeshFilter& filter) const final;
+
     glm::vec3 CalculateFirstPointInGrid() const final;
     glm::vec3 CalculateAbsoluteCoordinates(const glm::ivec3& coords) const final;
 
     void AddItem(nextfloor::mesh::Mesh* object) final;
+
+    /* Delta placement: only boxes entered or left since the last placement are updated */
+    void UpdateItem(nextfloor::mesh::Mesh* object) final;
     void RemoveMesh(nextfloor::mesh::Mesh* object) final;
     bool IsInside(const glm::vec3& location_object) const final;
 
+    /* Child grid side: the parent bit follows the occupancy mask emptiness */
+    void set_parent_grid(nextfloor::playground::Grid* parent_grid) final;
+
+    /* Parent grid side: one bit by box, apart from the occupancy mask of the grid own occupants */
+    void SetChildGridOccupancy(const glm::vec3& child_location, bool is_occupied) final;
+    bool IsChildGridOccupied(const glm::vec3& child_location) const final;
+
     void DisplayGrid() const final;
+    OccupancyStats CalculateOccupancyStats() const final;
     void ResetGrid() final;
 
+    /*
+     *  Loose placement: a mesh is only into the box of its center, queries are enlarged by the larger mesh half
+     *  dimension. Must be set before any placement.
+     */
+    void EnableLoosePlacement() { is_loose_placement_ = true; }
+
     glm::vec3 CalculateFrontSideLocation() const final;
     glm::vec3 CalculateRightSideLocation() const final;
     glm::vec3 CalculateBackSideLocation() const final;
@@ -75,6 +125,12 @@ protected:
               const glm::vec3& box_dimension,
               std::unique_ptr<nextfloor::mesh::GridBox>*** boxes);
 
+    /* Flat storage: all boxes into one array, linearly indexed */
+    WiredGrid(const glm::vec3& location,
+              const glm::ivec3& boxes_count,
+              const glm::vec3& box_dimension,
+              std::unique_ptr<FlatGridBox[]> flat_boxes);
+
     WiredGrid(WiredGrid&&) = delete;
     WiredGrid& operator=(WiredGrid&&) = delete;
     WiredGrid(const WiredGrid&) = delete;
@@ -84,8 +140,11 @@ protected:
 
     void DeleteGrid() noexcept;
 
-    nextfloor::mesh::GridBox* getGridBox(const glm::ivec3& coords)
+    nextfloor::mesh::GridBox* getGridBox(const glm::ivec3& coords) const
     {
+        if (flat_boxes_ != nullptr) {
+            return &flat_boxes_[CoordsToIndex(coords)];
+        }
         return boxes_[coords.x][coords.y][coords.z].get();
     }
 
@@ -110,13 +169,68 @@ private:
     static constexpr float kWallPadding = 0.25f;
     static constexpr float kWallDeepScale = 0.25f;
 
+    /*
+     *  Occupancy bitmask: one bit by box, boxes of a same (x, y) column are contiguous bits\n
+     *  A bit is set for each filled box, a box emptied by Mesh::ClearCoords keeps its bit until next grid update\n
+     *  Grids with more boxes disable the mask: all boxes are then seen as filled
+     */
+    static constexpr int kMaxBoxesCount = 512;
+    static constexpr int kOccupancyWordBits = 64;
+    static constexpr int kOccupancyWordsCount = kMaxBoxesCount / kOccupancyWordBits;
+    static constexpr int kStencilSide = 3;
+
     void InitBoxes();
 
+    int CoordsToIndex(const glm::ivec3& coords) const
+    {
+        return (coords.x * height_boxes_count() + coords.y) * depth_boxes_count() + coords.z;
+    }
+
+    void UpdateOccupancy(const glm::ivec3& coords);
+    void UpdateParentOccupancy();
+    bool IsOccupancySet(const glm::ivec3& coords) const;
+    bool IsOccupancyInRange(int first_index, int indexes_count) const;
+    uint64_t OccupancyBitsInRange(int first_index, int indexes_count) const;
+    uint32_t StencilOccupancy(const glm::ivec3& first_coords, const glm::ivec3& last_coords) const;
+    int AddOccupantsInRange(const glm::ivec3& min_coords,
+                            const glm::ivec3& max_coords,
+                            std::vector<nextfloor::mesh::Mesh*>* neighbors) const;
+    int CountBoxesInRange(const glm::ivec3& min_coords, const glm::ivec3& max_coords) const;
+    bool CalculateNeighborsRange(const nextfloor::mesh::Mesh& target,
+                                 glm::ivec3* min_coords,
+                                 glm::ivec3* max_coords) const;
+    void AddNewOccupantsOfBox(const glm::ivec3& coords,
+                              MeshMarks* marks,
+                              std::vector<nextfloor::mesh::Mesh*>* neighbors) const;
+    void AddOccupantsOfRing(const glm::ivec3& center_coords,
+                            int ring,
+                            MeshMarks* marks,
+                            std::vector<nextfloor::mesh::Mesh*>* neighbors) const;
+    float CalculateRingClearance(const glm::vec3& point, const glm::ivec3& center_coords, int ring) const;
+    bool IsRegionEmpty(const glm::ivec3& min_coords, const glm::ivec3& max_coords) const;
+    bool IsGridEmpty() const;
+
     std::vector<nextfloor::mesh::Mesh*> FindOccupants(const glm::ivec3& coords) const;
+    void FindNearerOccupantOnRay(const std::vector<nextfloor::mesh::Mesh*>& occupants,
+                                 const glm::vec3& origin,
+                                 const glm::vec3& direction,
+                                 const glm::vec2& ray_distances,
+                                 const MeshFilter& filter,
+                                 RayHit* nearer_hit) const;
     nextfloor::mesh::GridBox* AddItemToGrid(const glm::ivec3& coords, nextfloor::mesh::Mesh* object);
     void RemoveItemToGrid(const glm::ivec3& coords, nextfloor::mesh::Mesh* object);
+    void RemoveItemToBox(const glm::ivec3& coords, nextfloor::mesh::Mesh* object);
+    bool FindPlacementRange(const nextfloor::mesh::Mesh& object, glm::ivec3* min_coords, glm::ivec3* max_coords) const;
+    void CalculatePlacementRange(const nextfloor::mesh::Mesh& object,
+                                 glm::ivec3* min_coords,
+                                 glm::ivec3* max_coords) const;
+
+    glm::ivec3 CalculateLooseMargins(const nextfloor::mesh::Mesh& object) const;
+    void GrowLooseMargins(const nextfloor::mesh::Mesh& object);
+    glm::ivec3 loose_margins() const;
 
     glm::ivec3 PointToCoords(const glm::vec3& point) const;
+    glm::ivec3 PointToFloorCoords(const glm::vec3& point) const;
     glm::ivec3 CalculateCoordsLengthBetweenPoints(const glm::vec3& point_min, const glm::vec3& point_max);
     bool IsCooordsAreCorrect(const glm::ivec3& coords) const;
 
@@ -159,11 +273,25 @@ private:
     std::vector<nextfloor::mesh::Mesh*> FindBottomPositionCollisionNeighbors(const glm::vec3& coords) const;
     std::vector<nextfloor::mesh::Mesh*> FindTopPositionCollisionNeighbors(const glm::vec3& coords) const;
 
-    std::unique_ptr<nextfloor::mesh::GridBox>*** boxes_;
+    /* One of the 2 storages is used: nested arrays of boxes or flat array */
+    std::unique_ptr<nextfloor::mesh::GridBox>*** boxes_{nullptr};
+    std::unique_ptr<FlatGridBox[]> flat_boxes_{nullptr};
     glm::vec3 box_dimension_;
     glm::vec3 location_;
     glm::ivec3 boxes_count_;
     std::mutex mutex_;
+
+    /* Written by each box writer, read without lock */
+    bool is_occupancy_enabled_{true};
+    std::array<std::atomic<uint64_t>, kOccupancyWordsCount> occupancy_{};
+
+    /* Two levels occupancy: bits of the child grids (universe side) and grid to report into (room side) */
+    std::array<std::atomic<uint64_t>, kOccupancyWordsCount> child_occupancy_{};
+    nextfloor::playground::Grid* parent_grid_{nullptr};
+
+    /* Loose placement: boxes count to add on each axis around queries, only grown */
+    bool is_loose_placement_{false};
+    std::array<std::atomic<int>, 3> loose_margins_{};
 };
 
 }  // namespace layout
@@ -8,7 +8,6 @@
 
 #include <vector>
 #include <cassert>
-#include <mutex>
 
 #include "nextfloor/mesh/mesh.h"
 
@@ -29,26 +28,12 @@ void WiredGridBox::set_owner(nextfloor::playground::Grid* owner)
 
 void WiredGridBox::add(nextfloor::mesh::Mesh* object)
 {
-    assert(object != nullptr);
-
-    if (IsInto(*object)) {
-        return;
-    }
-
-    std::scoped_lock lock_map(mutex_);
-    occupants_.push_back(object);
+    occupants_.add(object);
 }
 
 void WiredGridBox::remove(nextfloor::mesh::Mesh* object)
 {
-    std::scoped_lock lock_map(mutex_);
-
-    for (auto cnt = 0; cnt < occupants_.size(); cnt++) {
-        if (occupants_[cnt] == object) {
-            occupants_.erase(occupants_.begin() + cnt);
-            return;
-        }
-    }
+    occupants_.remove(object);
 }
 
 void WiredGridBox::clear()
@@ -59,43 +44,46 @@ void WiredGridBox::clear()
 std::vector<nextfloor::mesh::Mesh*> WiredGridBox::occupants() const
 {
     std::vector<nextfloor::mesh::Mesh*> occupants;
-    for (auto& occupant : occupants_) {
-        auto meshes = occupant->leafs();
-        occupants.insert(occupants.end(), meshes.begin(), meshes.end());
-    }
+    occupants_.ForEach([&](nextfloor::mesh::Mesh* occupant) { occupant->AddLeafsTo(&occupants); });
 
     return occupants;
 }
 
+void WiredGridBox::AddOccupantsTo(std::vector<nextfloor::mesh::Mesh*>* occupants) const
+{
+    occupants_.ForEach([&](nextfloor::mesh::Mesh* occupant) { occupant->AddLeafsTo(occupants); });
+}
+
 std::vector<nextfloor::mesh::Mesh*> WiredGridBox::other_occupants(const nextfloor::mesh::Mesh& object) const
 {
     std::vector<nextfloor::mesh::Mesh*> others(0);
-    for (const auto& occupant : occupants_) {
+    occupants_.ForEach([&](nextfloor::mesh::Mesh* occupant) {
         if (occupant->id() != object.id()) {
             others.push_back(occupant);
         }
-    }
+    });
 
     return others;
 }
 
 nextfloor::mesh::Mesh* WiredGridBox::getFirstOccupant()
 {
-    if (occupants_.size() == 0) {
-        return nullptr;
-    }
+    nextfloor::mesh::Mesh* first_occupant = nullptr;
+    occupants_.ForEach([&](nextfloor::mesh::Mesh* occupant) {
+        if (first_occupant == nullptr) {
+            first_occupant = occupant;
+        }
+    });
 
-    return occupants_[0];
+    return first_occupant;
 }
 
 bool WiredGridBox::IsInto(const nextfloor::mesh::Mesh& object) const
 {
-    for (const auto& occupant : occupants_) {
-        if (object == *occupant) {
-            return true;
-        }
-    }
-    return false;
+    bool is_into = false;
+    occupants_.ForEach([&](nextfloor::mesh::Mesh* occupant) { is_into = is_into || object == *occupant; });
+
+    return is_into;
 }
 
 bool WiredGridBox::IsEmpty() const
@@ -10,11 +10,11 @@
 #include "nextfloor/mesh/grid_box.h"
 
 #include <glm/glm.hpp>
-#include <mutex>
 #include <vector>
 
 #include "nextfloor/playground/grid.h"
 #include "nextfloor/mesh/mesh.h"
+#include "nextfloor/layout/grid_box_occupants.h"
 
 namespace nextfloor {
 
@@ -56,15 +56,15 @@ public:
     glm::vec3 coords() const final { return coords_; }
 
     std::vector<nextfloor::mesh::Mesh*> occupants() const final;
+    void AddOccupantsTo(std::vector<nextfloor::mesh::Mesh*>* occupants) const final;
 
 protected:
     nextfloor::mesh::Mesh* getFirstOccupant();
 
 private:
-    std::vector<nextfloor::mesh::Mesh*> occupants_;
+    GridBoxOccupants occupants_;
     nextfloor::playground::Grid* owner_{nullptr};
     glm::vec3 coords_;
-    std::mutex mutex_;
 };
 
 }  // namespace layout
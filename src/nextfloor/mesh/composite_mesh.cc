@@ -28,12 +28,35 @@ std::vector<Mesh*> CompositeMesh::childs() const
 
 std::vector<Mesh*> CompositeMesh::leafs()
 {
-    std::vector<Mesh*> ret_childs(0);
+    return cached_leafs()->leafs;
+}
+
+void CompositeMesh::AddLeafsTo(std::vector<Mesh*>* leafs)
+{
+    auto cache = cached_leafs();
+    leafs->insert(leafs->end(), cache->leafs.begin(), cache->leafs.end());
+}
+
+/**
+ *  Rebuilt only after a change into the childs tree (add_child or remove_child increment the generation).
+ *  Readers keep their own reference on the cache, so a rebuild never frees a list still read
+ */
+std::shared_ptr<const CompositeMesh::LeafsCache> CompositeMesh::cached_leafs()
+{
+    auto cache = leafs_cache_.load(std::memory_order_acquire);
+    int generation = generation_;
+    if (cache != nullptr && cache->generation == generation) {
+        return cache;
+    }
+
+    auto new_cache = std::make_shared<LeafsCache>();
+    new_cache->generation = generation;
     for (auto& object : objects_) {
-        std::vector<Mesh*> grant_childs = object->leafs();
-        ret_childs.insert(ret_childs.end(), grant_childs.begin(), grant_childs.end());
+        object->AddLeafsTo(&new_cache->leafs);
     }
-    return ret_childs;
+    leafs_cache_.store(new_cache, std::memory_order_release);
+
+    return new_cache;
 }
 
 Mesh* CompositeMesh::add_child(std::unique_ptr<Mesh> object)
@@ -54,6 +77,7 @@ Mesh* CompositeMesh::add_child(std::unique_ptr<Mesh> object)
 
     /* Ensure object is well added */
     assert(objects_.size() == initial_objects_size + 1);
+    IncrementGeneration();
 
     return object_raw;
 }
@@ -78,6 +102,7 @@ std::unique_ptr<Mesh> CompositeMesh::remove_child(Mesh* child)
             objects_.erase(objects_.begin() + cnt);
             /* Ensure child is erased from current objects_ array */
             assert(initial_count_childs == objects_.size() + 1);
+            IncrementGeneration();
 
             return ret;
         }
@@ -86,6 +111,16 @@ std::unique_ptr<Mesh> CompositeMesh::remove_child(Mesh* child)
     return ret;
 }
 
+void CompositeMesh::IncrementGeneration()
+{
+    generation_++;
+
+    /* Ancestors see the change too */
+    if (parent_ != nullptr) {
+        parent_->IncrementGeneration();
+    }
+}
+
 void CompositeMesh::PrepareDraw(const glm::mat4& view_projection_matrix)
 {
     tbb::parallel_for(0, (int)objects_.size(), 1, [&](int i) { objects_[i]->PrepareDraw(view_projection_matrix); });
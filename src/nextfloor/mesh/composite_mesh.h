@@ -9,6 +9,7 @@
 
 #include "nextfloor/mesh/mesh.h"
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -33,7 +34,10 @@ public:
     bool hasNoChilds() const final { return objects_.size() == 0; }
 
     std::vector<Mesh*> leafs() final;
+    void AddLeafsTo(std::vector<Mesh*>* leafs) final;
     std::vector<Mesh*> childs() const final;
+    int generation() const final { return generation_; }
+    void IncrementGeneration() final;
     void PrepareDraw(const glm::mat4& view_projection_matrix) override;
 
     std::string class_name() const override { return "CompositeMesh"; }
@@ -47,6 +51,18 @@ protected:
     CompositeMesh& operator=(const CompositeMesh&) = delete;
 
     std::vector<std::unique_ptr<Mesh>> objects_;
+
+private:
+    /* Flattened leafs of the childs tree, valid while the generation is unchanged */
+    struct LeafsCache {
+        int generation;
+        std::vector<Mesh*> leafs;
+    };
+
+    std::shared_ptr<const LeafsCache> cached_leafs();
+
+    std::atomic<int> generation_{0};
+    std::atomic<std::shared_ptr<const LeafsCache>> leafs_cache_{nullptr};
 };
 
 }  // namespace mesh
@@ -25,6 +25,13 @@ void DrawingMesh::PrepareDraw(const glm::mat4& view_projection_matrix)
     });
 }
 
+void DrawingMesh::set_interpolation(float interpolation)
+{
+    for (auto& polygon : polygons_) {
+        polygon->set_interpolation(interpolation);
+    }
+}
+
 std::vector<std::pair<glm::mat4, std::string>> DrawingMesh::GetModelViewProjectionsAndTextureToDraw() const
 {
     std::vector<std::pair<glm::mat4, std::string>> mvps_with_texture;
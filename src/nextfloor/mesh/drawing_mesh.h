@@ -29,6 +29,7 @@ public:
 
     std::vector<std::pair<glm::mat4, std::string>> GetModelViewProjectionsAndTextureToDraw() const override;
     void PrepareDraw(const glm::mat4& view_projection_matrix) override;
+    void set_interpolation(float interpolation) final;
 
     std::string class_name() const override { return "DrawingMesh"; }
 
@@ -19,6 +19,12 @@ std::vector<Mesh*> DynamicMesh::FindCollisionNeighbors() const
     return parent_->FindCollisionNeighborsOf(*this);
 }
 
+std::vector<Mesh*> DynamicMesh::FindStaticCollisionNeighbors() const
+{
+    assert(parent_ != nullptr);
+    return parent_->FindStaticNeighborsOf(*this);
+}
+
 bool DynamicMesh::IsNeighborEligibleForCollision(const Mesh& neighbor) const
 {
     return IsInDirection(neighbor) && IsNeighborReachable(neighbor);
@@ -51,6 +57,18 @@ void DynamicMesh::set_movement(const glm::vec3& movement)
     for (auto& polygon : polygons_) {
         polygon->set_movement(movement);
     }
+
+    if (border_->IsMoved()) {
+        WakeUp();
+    }
+}
+
+void DynamicMesh::WakeUp()
+{
+    /* Not yet into the universe tree: the first moving objects search will find it */
+    if (parent_ != nullptr) {
+        parent_->AddActiveObject(this);
+    }
 }
 
 void DynamicMesh::set_move_factor(glm::vec3 move_factor)
@@ -25,12 +25,14 @@ public:
     ~DynamicMesh() override = default;
 
     std::vector<Mesh*> FindCollisionNeighbors() const final;
+    std::vector<Mesh*> FindStaticCollisionNeighbors() const final;
     bool IsNeighborEligibleForCollision(const Mesh& neighbor) const final;
     void MoveLocation() override;
 
     glm::vec3 movement() const final { return border_->movement(); }
 
     void set_movement(const glm::vec3& movement) final;
+    void WakeUp() final;
 
     std::string class_name() const override { return "DynamicMesh"; }
 
@@ -39,12 +41,14 @@ public:
         return obstacle_ == obstacle;
     }
 
+    /* No lock: collision engines apply hits from one thread (ApplyNearerHits, or a non concurrent single pair call) */
     void UpdateObstacleIfNearer(Mesh* obstacle, float distance_factor, glm::vec3 move_factor) final
     {
-        std::scoped_lock lock_map(mutex_);
-
-        /* Update obstacle and distance if lower than former */
+        /* Update obstacle and distance if lower than former. Static obstacles never move, no need to wake them */
         if (IsDistanceNearer(distance_factor)) {
+            if (obstacle_ != obstacle && !obstacle->IsStatic()) {
+                obstacle->WakeUp();
+            }
             obstacle_ = obstacle;
             set_move_factor(move_factor);
             set_distance_factor(distance_factor);
@@ -41,6 +41,8 @@ public:
     virtual glm::vec3 coords() const = 0;
     virtual std::vector<Mesh*> other_occupants(const Mesh& object) const = 0;
     virtual std::vector<Mesh*> occupants() const = 0;
+    /* Appends leafs of occupants, without temporary vectors */
+    virtual void AddOccupantsTo(std::vector<Mesh*>* occupants) const = 0;
 
     virtual bool IsFrontPositionFilled() const = 0;
     virtual bool IsRightPositionFilled() const = 0;
@@ -42,12 +42,14 @@ public:
 
     /* Dynamic methods - overrided by DynamicMesh */
     virtual std::vector<Mesh*> FindCollisionNeighbors() const { return std::vector<Mesh*>(0); }
+    virtual std::vector<Mesh*> FindStaticCollisionNeighbors() const { return std::vector<Mesh*>(0); }
     virtual bool IsNeighborEligibleForCollision(const Mesh& neighbor) const { return false; }
     virtual void MoveLocation() {}
     virtual glm::vec3 movement() const { return glm::vec3(0.0f); }
     virtual void set_distance_factor(float distance_factor) {}
     virtual void set_move_factor(glm::vec3 move_factor) {}
     virtual void set_movement(const glm::vec3& movement) {}
+    virtual void WakeUp() {}
 
     /* Placement methods - overrided by PlacementMesh */
     virtual std::vector<Mesh*> GetMovingObjects();
@@ -60,6 +62,7 @@ public:
     Border* border() const;
 
     void set_gridcoords(std::vector<GridBox*> coords_list);
+    const std::vector<GridBox*>& gridcoords() const { return coords_list_; }
     void ClearCoords();
     std::vector<glm::ivec3> coords() const;
     void delete_gridcoord(GridBox* grid_box);
@@ -70,11 +73,13 @@ public:
         return std::vector<std::pair<glm::mat4, std::string>>(0);
     }
     virtual void PrepareDraw(const glm::mat4& view_projection_matrix) {}
+    virtual void set_interpolation(float interpolation) {}
 
     /* Layout methodsi - overrided by ground objects */
     virtual bool hasLayout() const { return false; }
     virtual Mesh* UpdateChildPlacement(nextfloor::mesh::Mesh* child) { return nullptr; }
     virtual std::vector<Mesh*> FindCollisionNeighborsOf(const Mesh& target) const { return std::vector<Mesh*>(0); }
+    virtual std::vector<Mesh*> FindStaticNeighborsOf(const Mesh& target) const { return std::vector<Mesh*>(0); }
     virtual Mesh* AddIntoChild(std::unique_ptr<nextfloor::mesh::Mesh> mesh) { return nullptr; }
     virtual bool IsInside(const Mesh& mesh) const { return false; }
     virtual bool IsFrontPositionFilled() const { return true; }
@@ -83,6 +88,9 @@ public:
     virtual bool IsLeftPositionFilled() const { return true; }
     virtual bool IsBottomPositionFilled() const { return true; }
     virtual bool IsTopPositionFilled() const { return true; }
+    virtual void RemoveStaticMesh(Mesh* mesh) {}
+    virtual void AddActiveObject(Mesh* mesh) {}
+    virtual void RemoveActiveObject(Mesh* mesh) {}
 
     /* Composite Object methods - Overrided by CompositeMesh */
     virtual int id() const { return id_; }
@@ -92,11 +100,17 @@ public:
     virtual bool hasChilds() const { return false; }
     virtual bool hasNoChilds() const { return true; }
     virtual std::vector<Mesh*> leafs();
+    virtual void AddLeafsTo(std::vector<Mesh*>* leafs) { leafs->push_back(this); }
     virtual void set_parent(Mesh* parent) { parent_ = parent; }
+    /* Incremented each time the childs tree below this mesh changes */
+    virtual int generation() const { return 0; }
+    virtual void IncrementGeneration() {}
 
     /* Other */
     virtual bool IsCamera() const { return false; }
     virtual bool IsPlayer() const { return false; }
+    /* Never moves (wall bricks), placed into static trees instead of grids */
+    virtual bool IsStatic() const { return false; }
     virtual std::string class_name() const { return std::string("Mesh"); }
 
 protected:
@@ -34,6 +34,7 @@ public:
     virtual void set_distance_factor(float distance_factor) = 0;
     virtual void set_move_factor(glm::vec3 move_factor) = 0;
     virtual void set_movement(const glm::vec3& move) = 0;
+    virtual void set_interpolation(float interpolation) = 0;
 
     virtual glm::vec3 movement() const = 0;
     virtual glm::vec3 location() const = 0;
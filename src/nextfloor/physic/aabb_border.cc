@@ -0,0 +1,132 @@
+/**
+ *  @file aabb_border.cc
+ *  @brief AabbBorder class file
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#include "nextfloor/physic/aabb_border.h"
+
+namespace nextfloor {
+
+namespace physic {
+
+namespace {
+
+/* Corners of the unit cube, 4 for each face (front, back, left, right, top, bottom) */
+static const glm::vec3 sUnitCorners[8] = {{-1.0f, 1.0f, 1.0f},
+                                          {1.0f, 1.0f, 1.0f},
+                                          {1.0f, -1.0f, 1.0f},
+                                          {-1.0f, -1.0f, 1.0f},
+                                          {-1.0f, 1.0f, -1.0f},
+                                          {1.0f, 1.0f, -1.0f},
+                                          {1.0f, -1.0f, -1.0f},
+                                          {-1.0f, -1.0f, -1.0f}};
+static const int sFacesCorners[24] = {0, 1, 2, 3, 4, 5, 6, 7, 0, 4, 7, 3, 1, 5, 6, 2, 0, 4, 5, 1, 3, 7, 6, 2};
+
+}  // anonymous namespace
+
+AabbBorder::AabbBorder(const glm::vec3& location, const glm::vec3& scale)
+{
+    location_ = location;
+    scale_ = scale;
+}
+
+std::vector<glm::vec3> AabbBorder::getCoordsModelMatrixComputed() const
+{
+    std::vector<glm::vec3> coords(0);
+    coords.reserve(24);
+    for (auto& corner_index : sFacesCorners) {
+        coords.push_back(CalculateCorner(sUnitCorners[corner_index]));
+    }
+
+    return coords;
+}
+
+float AabbBorder::CalculateWidth() const
+{
+    return CalculateCorner(sUnitCorners[1]).x - getFirstPoint().x;
+}
+
+float AabbBorder::CalculateHeight() const
+{
+    return CalculateCorner(sUnitCorners[3]).y - getFirstPoint().y;
+}
+
+float AabbBorder::CalculateDepth() const
+{
+    return CalculateCorner(sUnitCorners[4]).z - getFirstPoint().z;
+}
+
+glm::vec3 AabbBorder::getFirstPoint() const
+{
+    auto first_point = CalculateCorner(sUnitCorners[0]);
+    auto last_point = CalculateCorner(sUnitCorners[6]);
+
+    /* Add padding */
+    for (auto axis = 0; axis < 3; axis++) {
+        first_point[axis] += first_point[axis] < last_point[axis] ? kPoinstStep : -kPoinstStep;
+    }
+
+    return first_point;
+}
+
+glm::vec3 AabbBorder::getLastPoint() const
+{
+    auto first_point = CalculateCorner(sUnitCorners[0]);
+    auto last_point = CalculateCorner(sUnitCorners[6]);
+
+    /* Add padding */
+    for (auto axis = 0; axis < 3; axis++) {
+        last_point[axis] += first_point[axis] < last_point[axis] ? -kPoinstStep : kPoinstStep;
+    }
+
+    return last_point;
+}
+
+bool AabbBorder::IsObstacleInCollisionAfterPartedMove(const nextfloor::mesh::Border& obstacle, float move_part) const
+{
+    return IsObstacleInSameWidthAfterPartedMove(obstacle, move_part)
+           && IsObstacleInSameHeightAfterPartedMove(obstacle, move_part)
+           && IsObstacleInSameDepthAfterPartedMove(obstacle, move_part);
+}
+
+bool AabbBorder::IsObstacleInSameWidthAfterPartedMove(const nextfloor::mesh::Border& obstacle, float move_part) const
+{
+    auto current_x_afer_parted_move = RetrieveFirstPointAfterPartedMove(move_part).x;
+    auto obstacle_x_afer_parted_move = obstacle.RetrieveFirstPointAfterPartedMove(move_part).x;
+
+    return current_x_afer_parted_move <= obstacle_x_afer_parted_move + obstacle.CalculateWidth()
+           && obstacle_x_afer_parted_move <= current_x_afer_parted_move + CalculateWidth();
+}
+
+bool AabbBorder::IsObstacleInSameHeightAfterPartedMove(const nextfloor::mesh::Border& obstacle, float move_part) const
+{
+    auto current_y_afer_parted_move = RetrieveFirstPointAfterPartedMove(move_part).y;
+    auto obstacle_y_afer_parted_move = obstacle.RetrieveFirstPointAfterPartedMove(move_part).y;
+
+    return current_y_afer_parted_move >= obstacle_y_afer_parted_move + obstacle.CalculateHeight()
+           && obstacle_y_afer_parted_move >= current_y_afer_parted_move + CalculateHeight();
+}
+
+bool AabbBorder::IsObstacleInSameDepthAfterPartedMove(const nextfloor::mesh::Border& obstacle, float move_part) const
+{
+    auto current_z_afer_parted_move = RetrieveFirstPointAfterPartedMove(move_part).z;
+    auto obstacle_z_afer_parted_move = obstacle.RetrieveFirstPointAfterPartedMove(move_part).z;
+
+    return current_z_afer_parted_move >= obstacle_z_afer_parted_move + obstacle.CalculateDepth()
+           && obstacle_z_afer_parted_move >= current_z_afer_parted_move + CalculateDepth();
+}
+
+glm::vec3 AabbBorder::RetrieveFirstPointAfterPartedMove(float move_part) const
+{
+    return getFirstPoint() + move_part * movement_;
+}
+
+void AabbBorder::ComputeNewLocation()
+{
+    MoveLocation();
+}
+
+}  // namespace physic
+
+}  // namespace nextfloor
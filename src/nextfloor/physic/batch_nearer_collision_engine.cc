@@ -0,0 +1,120 @@
+/**
+ *  @file batch_nearer_collision_engine.cc
+ *  @brief Whole frame batch version for CollisionEngine
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#include "nextfloor/physic/batch_nearer_collision_engine.h"
+
+#include <tbb/tbb.h>
+#include <cassert>
+
+#include "nextfloor/mesh/border.h"
+#include "nextfloor/physic/swept_box.h"
+#include "nextfloor/core/common_services.h"
+
+namespace nextfloor {
+
+namespace physic {
+
+BatchNearerCollisionEngine::BatchNearerCollisionEngine(int granularity, int search)
+  : NearerCollisionEngine(granularity, search)
+{}
+
+void BatchNearerCollisionEngine::DetectCollision(const std::vector<CollisionPair>& pairs)
+{
+    pair_cache_.ClearIfFull();
+
+    std::vector<CollisionPair> tested_pairs = GatherTestedPairs(pairs);
+    FillSweptBoxes(tested_pairs);
+
+    entry_times_.resize(tested_pairs.size());
+    tbb::parallel_for(tbb::blocked_range<int>(0, (int)tested_pairs.size(), kPairsByTask),
+                      [&](const tbb::blocked_range<int>& range) {
+                          ComputePairwiseSweptEntryTimes(target_boxes_,
+                                                         obstacle_boxes_,
+                                                         range.begin(),
+                                                         range.end(),
+                                                         entry_times_.data());
+                      });
+    nextfloor::core::CommonServices::getCollisionStats()->AddNarrowEvaluations(tested_pairs.size());
+
+    ScatterCollisionHits(tested_pairs);
+}
+
+std::vector<CollisionPair> BatchNearerCollisionEngine::GatherTestedPairs(const std::vector<CollisionPair>& pairs) const
+{
+    /* Each task updates its own pair, then the pairs to compute are kept in order */
+    std::vector<CollisionPair> checked_pairs(pairs);
+    std::vector<char> tested_flags(pairs.size(), 0);
+    tbb::parallel_for(0, (int)checked_pairs.size(), 1, [&](int i) {
+        CollisionPair& pair = checked_pairs[i];
+        assert(pair.first->id() != pair.second->id());
+        pair.is_first_updated = pair.is_first_updated && !IsSameLastObstacle(pair.first, pair.second);
+        pair.is_second_updated = pair.is_second_updated && !IsSameLastObstacle(pair.second, pair.first);
+        tested_flags[i] = (pair.is_first_updated || pair.is_second_updated)
+                          && !pair_cache_.IsSeparated(pair.first, pair.second);
+    });
+
+    std::vector<CollisionPair> tested_pairs;
+    tested_pairs.reserve(checked_pairs.size());
+    for (auto cnt = 0; cnt < (int)checked_pairs.size(); cnt++) {
+        if (tested_flags[cnt]) {
+            tested_pairs.push_back(checked_pairs[cnt]);
+        }
+    }
+
+    return tested_pairs;
+}
+
+void BatchNearerCollisionEngine::FillSweptBoxes(const std::vector<CollisionPair>& tested_pairs)
+{
+    ResizeSweptBoxes(&target_boxes_, tested_pairs.size());
+    ResizeSweptBoxes(&obstacle_boxes_, tested_pairs.size());
+    tbb::parallel_for(0, (int)tested_pairs.size(), 1, [&](int i) {
+        SetSweptBox(&target_boxes_, i, MakeSweptBox(*tested_pairs[i].first->border()));
+        SetSweptBox(&obstacle_boxes_, i, MakeSweptBox(*tested_pairs[i].second->border()));
+    });
+}
+
+void BatchNearerCollisionEngine::ScatterCollisionHits(const std::vector<CollisionPair>& tested_pairs)
+{
+    tbb::combinable<std::vector<CollisionHit>> thread_hits;
+    tbb::parallel_for(0, (int)tested_pairs.size(), 1, [&](int i) {
+        const CollisionPair& pair = tested_pairs[i];
+        pair_cache_.Update(pair.first, pair.second, entry_times_[i] < 1.0f);
+        if (entry_times_[i] >= 1.0f) {
+            return;
+        }
+
+        if (pair.is_first_updated) {
+            thread_hits.local().push_back(CollisionHit{pair.first, pair.second, entry_times_[i], glm::vec3(-1.0f)});
+        }
+        if (pair.is_second_updated) {
+            thread_hits.local().push_back(CollisionHit{pair.second, pair.first, entry_times_[i], glm::vec3(-1.0f)});
+        }
+    });
+
+    std::vector<CollisionHit> hits;
+    thread_hits.combine_each([&](const std::vector<CollisionHit>& local_hits) {
+        hits.insert(hits.end(), local_hits.begin(), local_hits.end());
+    });
+    ApplyNearerHits(&hits);
+}
+
+PartialMove BatchNearerCollisionEngine::ComputeCollision(nextfloor::mesh::Mesh* target, nextfloor::mesh::Mesh* obstacle)
+{
+    PartialMove default_move{1.0f, glm::vec3(1.0f)};
+
+    nextfloor::core::CommonServices::getCollisionStats()->AddNarrowEvaluations(1);
+    float entry_time = ComputeSweptEntryTime(MakeSweptBox(*target->border()), MakeSweptBox(*obstacle->border()));
+    if (entry_time < 1.0f) {
+        return PartialMove{entry_time, glm::vec3(-1.0f)};
+    }
+
+    return default_move;
+}
+
+}  // namespace physic
+
+}  // namespace nextfloor
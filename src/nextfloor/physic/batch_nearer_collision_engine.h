@@ -0,0 +1,56 @@
+/**
+ *  @file batch_nearer_collision_engine.h
+ *  @brief BatchNearerCollisionEngine class header
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_PHYSIC_BATCHNEARERCOLLISIONENGINE_H_
+#define NEXTFLOOR_PHYSIC_BATCHNEARERCOLLISIONENGINE_H_
+
+#include "nextfloor/physic/nearer_collision_engine.h"
+
+#include <vector>
+
+#include "nextfloor/physic/swept_box_kernel.h"
+
+namespace nextfloor {
+
+namespace physic {
+
+/**
+ *  @class BatchNearerCollisionEngine
+ *  @brief Whole frame batch: every pair of the frame into one flat structure of arrays,\n
+ *  then one data parallel pass of the swept box kernel (granularity and search mode have no effect)
+ */
+class BatchNearerCollisionEngine : public NearerCollisionEngine {
+
+public:
+    BatchNearerCollisionEngine(int granularity, int search);
+    ~BatchNearerCollisionEngine() final = default;
+
+    using NearerCollisionEngine::DetectCollision;
+
+    /* Gather the pairs, solve all of them, then scatter the hits to the meshes */
+    void DetectCollision(const std::vector<CollisionPair>& pairs) final;
+
+    PartialMove ComputeCollision(nextfloor::mesh::Mesh* target, nextfloor::mesh::Mesh* obstacle) final;
+
+private:
+    /* Pairs by task: large enough for full simd lanes and a cheap tbb scheduling */
+    static constexpr int kPairsByTask = 256;
+
+    std::vector<CollisionPair> GatherTestedPairs(const std::vector<CollisionPair>& pairs) const;
+    void FillSweptBoxes(const std::vector<CollisionPair>& tested_pairs);
+    void ScatterCollisionHits(const std::vector<CollisionPair>& tested_pairs);
+
+    /* Flat buffers, kept from one frame to the next to avoid reallocations */
+    SweptBoxes target_boxes_;
+    SweptBoxes obstacle_boxes_;
+    std::vector<float> entry_times_;
+};
+
+}  // namespace physic
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_PHYSIC_BATCHNEARERCOLLISIONENGINE_H_
@@ -0,0 +1,41 @@
+/**
+ *  @file broadphase.h
+ *  @brief Broadphase class header
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_PHYSIC_BROADPHASE_H_
+#define NEXTFLOOR_PHYSIC_BROADPHASE_H_
+
+#include <vector>
+
+#include "nextfloor/mesh/mesh.h"
+
+namespace nextfloor {
+
+namespace physic {
+
+/**
+ *  @class Broadphase
+ *  @brief Interface who selects, each frame, the candidate obstacles of moving objects
+ */
+class Broadphase {
+
+public:
+    static constexpr int kBroadphaseGrid = 1;
+    static constexpr int kBroadphaseSweepAndPrune = 2;
+
+    virtual ~Broadphase() = default;
+
+    /* Refresh broadphase state before collision computes of the frame */
+    virtual void Update(nextfloor::mesh::Mesh* universe, const std::vector<nextfloor::mesh::Mesh*>& moving_objects) = 0;
+
+    /* Candidate obstacles for pivot, must be thread safe */
+    virtual std::vector<nextfloor::mesh::Mesh*> FindCollisionNeighbors(nextfloor::mesh::Mesh* pivot) const = 0;
+};
+
+}  // namespace physic
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_PHYSIC_BROADPHASE_H_
@@ -7,6 +7,8 @@
 #ifndef NEXTFLOOR_GAMEPLAY_COLLISIONENGINE_H_
 #define NEXTFLOOR_GAMEPLAY_COLLISIONENGINE_H_
 
+#include <vector>
+
 #include "nextfloor/mesh/mesh.h"
 
 namespace nextfloor {
@@ -21,9 +23,20 @@ typedef struct {
     glm::vec3 movement_factor_update;
 } PartialMove;
 
+/**
+ *  Unordered pair of meshes, lower id first, with the sides which take the collision result
+ */
+typedef struct {
+    nextfloor::mesh::Mesh* first;
+    nextfloor::mesh::Mesh* second;
+    bool is_first_updated;
+    bool is_second_updated;
+} CollisionPair;
+
 /**
  *  @class EngineCollision
  *  @brief Interface who manage collisition computes between 3d models\n
+ *  Meshes are updated without lock: DetectCollision calls are not to be run concurrently
  */
 class CollisionEngine {
 
@@ -33,6 +46,12 @@ public:
     /* Template Method : Detect if a collision exists between target and obstacle. */
     virtual void DetectCollision(nextfloor::mesh::Mesh* target, nextfloor::mesh::Mesh* obstacle) = 0;
 
+    /* Template Method : Compute once the collision of a pair, and update the two sides if needed */
+    virtual void DetectCollision(const CollisionPair& pair) = 0;
+
+    /* Detect collisions of all the pairs of the frame */
+    virtual void DetectCollision(const std::vector<CollisionPair>& pairs) = 0;
+
     /**
      *  Primitive Operation subclassed: compute collision distance between borders of 2 objects
      *  @return parted (as fraction of setted move) distance between the 2 borders
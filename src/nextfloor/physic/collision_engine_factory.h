@@ -10,6 +10,7 @@
 #include <memory>
 
 #include "nextfloor/physic/collision_engine.h"
+#include "nextfloor/physic/broadphase.h"
 
 namespace nextfloor {
 
@@ -23,7 +24,8 @@ class CollisionEngineFactory {
 
 public:
     virtual ~CollisionEngineFactory() = default;
-    virtual std::unique_ptr<CollisionEngine> MakeCollisionEngine(int type, int granularity) const = 0;
+    virtual std::unique_ptr<CollisionEngine> MakeCollisionEngine(int type, int granularity, int search) const = 0;
+    virtual std::unique_ptr<Broadphase> MakeBroadphase(int type) const = 0;
 };
 
 }  // namespace physic
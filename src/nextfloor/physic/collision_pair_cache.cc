@@ -0,0 +1,83 @@
+/**
+ *  @file collision_pair_cache.cc
+ *  @brief CollisionPairCache class file
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#include "nextfloor/physic/collision_pair_cache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace nextfloor {
+
+namespace physic {
+
+namespace {
+
+float MaxAbsComponent(const glm::vec3& vector)
+{
+    return std::max({std::abs(vector.x), std::abs(vector.y), std::abs(vector.z)});
+}
+
+/* Bound (on each axis) of the distance travelled since the cached frame, current move included */
+float CalculateTravelBound(nextfloor::mesh::Mesh* mesh, const glm::vec3& cached_location)
+{
+    return MaxAbsComponent(mesh->location() - cached_location) + MaxAbsComponent(mesh->movement());
+}
+
+/* Greatest gap between the unpadded boxes over the 3 axis, negative if boxes overlap */
+float CalculateSeparation(nextfloor::mesh::Mesh* first, nextfloor::mesh::Mesh* second)
+{
+    glm::vec3 gaps = glm::abs(first->location() - second->location())
+                     - (first->dimension() + second->dimension()) / 2.0f;
+    return std::max({gaps.x, gaps.y, gaps.z});
+}
+
+}  // anonymous namespace
+
+bool CollisionPairCache::IsSeparated(nextfloor::mesh::Mesh* first, nextfloor::mesh::Mesh* second) const
+{
+    if (first->id() > second->id()) {
+        std::swap(first, second);
+    }
+
+    tbb::concurrent_hash_map<uint64_t, PairSeparation>::const_accessor accessor;
+    if (!separations_.find(accessor, MakeKey(first, second))) {
+        return false;
+    }
+
+    float travel_bound = CalculateTravelBound(first, accessor->second.lower_location)
+                         + CalculateTravelBound(second, accessor->second.upper_location);
+    return travel_bound < accessor->second.separation;
+}
+
+void CollisionPairCache::Update(nextfloor::mesh::Mesh* first, nextfloor::mesh::Mesh* second, bool is_collision)
+{
+    if (first->id() > second->id()) {
+        std::swap(first, second);
+    }
+
+    auto key = MakeKey(first, second);
+    float separation = CalculateSeparation(first, second);
+    if (is_collision || separation <= 0.0f) {
+        separations_.erase(key);
+        return;
+    }
+
+    tbb::concurrent_hash_map<uint64_t, PairSeparation>::accessor accessor;
+    separations_.insert(accessor, key);
+    accessor->second = PairSeparation{separation, first->location(), second->location()};
+}
+
+void CollisionPairCache::ClearIfFull()
+{
+    if (separations_.size() > kMaxEntries) {
+        separations_.clear();
+    }
+}
+
+}  // namespace physic
+
+}  // namespace nextfloor
@@ -0,0 +1,61 @@
+/**
+ *  @file collision_pair_cache.h
+ *  @brief CollisionPairCache class header
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_PHYSIC_COLLISIONPAIRCACHE_H_
+#define NEXTFLOOR_PHYSIC_COLLISIONPAIRCACHE_H_
+
+#include <tbb/concurrent_hash_map.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+
+#include "nextfloor/mesh/mesh.h"
+
+namespace nextfloor {
+
+namespace physic {
+
+/**
+ *  @class CollisionPairCache
+ *  @brief Temporal coherence between frames: keeps the separation of far pairs,\n
+ *  so their narrow phase is skipped until both meshes could have closed the gap
+ */
+class CollisionPairCache {
+
+public:
+    /* Stale entries (removed or far away meshes) are dropped beyond this size */
+    static constexpr size_t kMaxEntries = 1 << 16;
+
+    /* True if the pair cannot be in collision for the current moves */
+    bool IsSeparated(nextfloor::mesh::Mesh* first, nextfloor::mesh::Mesh* second) const;
+
+    /* Record the pair after a narrow phase compute, a collision forgets it */
+    void Update(nextfloor::mesh::Mesh* first, nextfloor::mesh::Mesh* second, bool is_collision);
+
+    /* Not thread safe: must be called outside of the parallel detection */
+    void ClearIfFull();
+
+private:
+    typedef struct {
+        float separation;
+        glm::vec3 lower_location;
+        glm::vec3 upper_location;
+    } PairSeparation;
+
+    /* Key and locations are ordered by mesh id: the pair is the same for the two sides */
+    static uint64_t MakeKey(nextfloor::mesh::Mesh* lower, nextfloor::mesh::Mesh* upper)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(lower->id())) << 32)
+               | static_cast<uint32_t>(upper->id());
+    }
+
+    tbb::concurrent_hash_map<uint64_t, PairSeparation> separations_;
+};
+
+}  // namespace physic
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_PHYSIC_COLLISIONPAIRCACHE_H_
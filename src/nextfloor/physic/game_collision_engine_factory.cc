@@ -11,22 +11,34 @@
 #include <cassert>
 
 #include "nextfloor/physic/tbb_nearer_collision_engine.h"
+#include "nextfloor/physic/batch_nearer_collision_engine.h"
+#include "nextfloor/physic/grid_broadphase.h"
+#include "nextfloor/physic/sweep_and_prune_broadphase.h"
 #include "nextfloor/physic/serial_nearer_collision_engine.h"
+#include "nextfloor/physic/swept_nearer_collision_engine.h"
 
 namespace nextfloor {
 
 namespace physic {
 
-std::unique_ptr<CollisionEngine> GameCollisionEngineFactory::MakeCollisionEngine(int type, int granularity) const
+std::unique_ptr<CollisionEngine> GameCollisionEngineFactory::MakeCollisionEngine(int type,
+                                                                                 int granularity,
+                                                                                 int search) const
 {
     std::unique_ptr<CollisionEngine> engine_collision{nullptr};
 
     switch (type) {  // clang-format off
         case NearerCollisionEngine::kParallellTbb:
-            engine_collision = std::make_unique<TbbNearerCollisionEngine>(granularity);
+            engine_collision = std::make_unique<TbbNearerCollisionEngine>(granularity, search);
+            break;
+        case NearerCollisionEngine::kParallellBatch:
+            engine_collision = std::make_unique<BatchNearerCollisionEngine>(granularity, search);
+            break;
+        case NearerCollisionEngine::kParallellSwept:
+            engine_collision = std::make_unique<SweptNearerCollisionEngine>(granularity, search);
             break;
         default:
-            engine_collision = std::make_unique<SerialNearerCollisionEngine>(granularity);
+            engine_collision = std::make_unique<SerialNearerCollisionEngine>(granularity, search);
             break;
     }  // clang-format on
 
@@ -35,6 +47,24 @@ std::unique_ptr<CollisionEngine> GameCollisionEngineFactory::MakeCollisionEngine
     return engine_collision;
 }
 
+std::unique_ptr<Broadphase> GameCollisionEngineFactory::MakeBroadphase(int type) const
+{
+    std::unique_ptr<Broadphase> broadphase{nullptr};
+
+    switch (type) {  // clang-format off
+        case Broadphase::kBroadphaseSweepAndPrune:
+            broadphase = std::make_unique<SweepAndPruneBroadphase>();
+            break;
+        default:
+            broadphase = std::make_unique<GridBroadphase>();
+            break;
+    }  // clang-format on
+
+    assert(broadphase != nullptr);
+
+    return broadphase;
+}
+
 }  // namespace physic
 
 }  // namespace nextfloor
@@ -20,7 +20,8 @@ namespace physic {
 class GameCollisionEngineFactory : public CollisionEngineFactory {
 
 public:
-    std::unique_ptr<CollisionEngine> MakeCollisionEngine(int type, int granularity) const final;
+    std::unique_ptr<CollisionEngine> MakeCollisionEngine(int type, int granularity, int search) const final;
+    std::unique_ptr<Broadphase> MakeBroadphase(int type) const final;
 };
 
 }  // namespace physic
@@ -0,0 +1,20 @@
+/**
+ *  @file grid_broadphase.cc
+ *  @brief GridBroadphase class file
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#include "nextfloor/physic/grid_broadphase.h"
+
+namespace nextfloor {
+
+namespace physic {
+
+std::vector<nextfloor::mesh::Mesh*> GridBroadphase::FindCollisionNeighbors(nextfloor::mesh::Mesh* pivot) const
+{
+    return pivot->FindCollisionNeighbors();
+}
+
+}  // namespace physic
+
+}  // namespace nextfloor
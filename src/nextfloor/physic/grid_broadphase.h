@@ -0,0 +1,34 @@
+/**
+ *  @file grid_broadphase.h
+ *  @brief GridBroadphase class header
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_PHYSIC_GRIDBROADPHASE_H_
+#define NEXTFLOOR_PHYSIC_GRIDBROADPHASE_H_
+
+#include "nextfloor/physic/broadphase.h"
+
+namespace nextfloor {
+
+namespace physic {
+
+/**
+ *  @class GridBroadphase
+ *  @brief Delegates neighbors queries to the grids of the playground
+ */
+class GridBroadphase : public Broadphase {
+
+public:
+    GridBroadphase() = default;
+    ~GridBroadphase() final = default;
+
+    void Update(nextfloor::mesh::Mesh* universe, const std::vector<nextfloor::mesh::Mesh*>& moving_objects) final {}
+    std::vector<nextfloor::mesh::Mesh*> FindCollisionNeighbors(nextfloor::mesh::Mesh* pivot) const final;
+};
+
+}  // namespace physic
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_PHYSIC_GRIDBROADPHASE_H_
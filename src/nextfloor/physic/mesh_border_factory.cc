@@ -9,7 +9,7 @@
 
 #include <glm/glm.hpp>
 
-#include "nextfloor/physic/cube_border.h"
+#include "nextfloor/physic/aabb_border.h"
 
 namespace nextfloor {
 
@@ -23,7 +23,7 @@ std::unique_ptr<nextfloor::mesh::Border> MeshBorderFactory::MakeBorder(const glm
 std::unique_ptr<nextfloor::mesh::Border> MeshBorderFactory::MakeBorder(const glm::vec3& location,
                                                                        const glm::vec3& scale) const
 {
-    return std::make_unique<CubeBorder>(location, scale);
+    return std::make_unique<AabbBorder>(location, scale);
 }
 
 }  // namespace physic
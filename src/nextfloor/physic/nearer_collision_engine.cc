@@ -6,21 +6,168 @@
 
 #include "nextfloor/physic/nearer_collision_engine.h"
 
+#include <tbb/tbb.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "nextfloor/mesh/border.h"
+#include "nextfloor/physic/swept_box.h"
+#include "nextfloor/core/common_services.h"
+
 namespace nextfloor {
 
 namespace physic {
 
 void NearerCollisionEngine::DetectCollision(nextfloor::mesh::Mesh* target, nextfloor::mesh::Mesh* obstacle)
 {
-    /* 2 objects cannot themselves in collision, but player (camera) */
-    if (!target->IsCamera() && target->IsLastObstacle(obstacle)) {
+    if (IsSameLastObstacle(target, obstacle)) {
         return;
     }
 
     PartialMove collision_factor = ComputeCollision(target, obstacle);
+    if (collision_factor.distance_factor < 1.0f) {
+        nextfloor::core::CommonServices::getCollisionStats()->AddHits(1);
+    }
     target->UpdateObstacleIfNearer(obstacle, collision_factor.distance_factor, collision_factor.movement_factor_update);
 }
 
+void NearerCollisionEngine::DetectCollision(const CollisionPair& pair)
+{
+    std::vector<CollisionHit> hits;
+    ComputeCollisionHits(pair, &hits);
+    nextfloor::core::CommonServices::getCollisionStats()->AddHits(hits.size());
+    for (auto& hit : hits) {
+        hit.target->UpdateObstacleIfNearer(hit.obstacle, hit.distance_factor, hit.move_factor);
+    }
+}
+
+void NearerCollisionEngine::ComputeCollisionHits(const CollisionPair& pair, std::vector<CollisionHit>* hits)
+{
+    bool is_first_updated = pair.is_first_updated && !IsSameLastObstacle(pair.first, pair.second);
+    bool is_second_updated = pair.is_second_updated && !IsSameLastObstacle(pair.second, pair.first);
+    if (!is_first_updated && !is_second_updated) {
+        return;
+    }
+
+    if (pair_cache_.IsSeparated(pair.first, pair.second)) {
+        return;
+    }
+
+    /* Collision test is symmetric: one compute for the two sides */
+    PartialMove collision_factor = ComputeCollision(pair.first, pair.second);
+    bool is_collision = collision_factor.distance_factor < 1.0f;
+    pair_cache_.Update(pair.first, pair.second, is_collision);
+    if (!is_collision) {
+        return;
+    }
+
+    float distance_factor = collision_factor.distance_factor;
+    glm::vec3 move_factor = collision_factor.movement_factor_update;
+    if (is_first_updated) {
+        hits->push_back(CollisionHit{pair.first, pair.second, distance_factor, move_factor});
+    }
+    if (is_second_updated) {
+        hits->push_back(CollisionHit{pair.second, pair.first, distance_factor, move_factor});
+    }
+}
+
+void NearerCollisionEngine::ApplyNearerHits(std::vector<CollisionHit>* hits)
+{
+    nextfloor::core::CommonServices::getCollisionStats()->AddHits(hits->size());
+
+    std::sort(hits->begin(), hits->end(), [](const CollisionHit& hit1, const CollisionHit& hit2) {
+        if (hit1.target->id() != hit2.target->id()) {
+            return hit1.target->id() < hit2.target->id();
+        }
+        if (hit1.distance_factor != hit2.distance_factor) {
+            return hit1.distance_factor < hit2.distance_factor;
+        }
+        return hit1.obstacle->id() < hit2.obstacle->id();
+    });
+
+    for (auto cnt = 0; cnt < (int)hits->size(); cnt++) {
+        auto& hit = (*hits)[cnt];
+        if (cnt == 0 || hit.target != (*hits)[cnt - 1].target) {
+            hit.target->UpdateObstacleIfNearer(hit.obstacle, hit.distance_factor, hit.move_factor);
+        }
+    }
+}
+
+PartialMove NearerCollisionEngine::ComputeCollisionByBisection(nextfloor::mesh::Mesh* target,
+                                                               nextfloor::mesh::Mesh* obstacle) const
+{
+    PartialMove default_move{1.0f, glm::vec3(1.0f)};
+    nextfloor::mesh::Border* target_border = target->border();
+    nextfloor::mesh::Border* obstacle_border = obstacle->border();
+
+    long long evaluations_count = 0;
+    auto is_collision_at_step = [&](int step) {
+        evaluations_count++;
+        float parted_move = static_cast<float>(step) / granularity_;
+        return target_border->IsObstacleInCollisionAfterPartedMove(*obstacle_border, parted_move);
+    };
+
+    /* Full move first */
+    int collision_step = 0;
+    if (is_collision_at_step(granularity_)) {
+        collision_step = granularity_;
+    }
+    else {
+        /* Move can go through the obstacle: swept boxes (sampled test bounds) give the first step into it */
+        float entry_time = ComputeSweptEntryTime(MakeSweptBox(*target_border), MakeSweptBox(*obstacle_border));
+        if (entry_time < 1.0f) {
+            int entry_step = std::clamp(static_cast<int>(std::ceil(entry_time * granularity_)), 1, granularity_);
+
+            /* Neighbor steps are tested too against rounding */
+            int last_step = std::min(entry_step + 1, granularity_);
+            for (int step = std::max(entry_step - 1, 1); step <= last_step && collision_step == 0; step++) {
+                if (is_collision_at_step(step)) {
+                    collision_step = step;
+                }
+            }
+        }
+    }
+
+    if (collision_step == 0) {
+        nextfloor::core::CommonServices::getCollisionStats()->AddNarrowEvaluations(evaluations_count);
+        return default_move;
+    }
+
+    /* Colliding steps are contiguous (linear moves): the first one is into ]free_step, collision_step] */
+    int free_step = 0;
+    while (collision_step - free_step > 1) {
+        int middle_step = (free_step + collision_step) / 2;
+        if (is_collision_at_step(middle_step)) {
+            collision_step = middle_step;
+        }
+        else {
+            free_step = middle_step;
+        }
+    }
+
+    nextfloor::core::CommonServices::getCollisionStats()->AddNarrowEvaluations(evaluations_count);
+    float factor_move = static_cast<float>(collision_step - 1) / granularity_;
+    return PartialMove{factor_move, glm::vec3(-1.0f)};
+}
+
+void NearerCollisionEngine::DetectCollision(const std::vector<CollisionPair>& pairs)
+{
+    pair_cache_.ClearIfFull();
+
+    tbb::combinable<std::vector<CollisionHit>> thread_hits;
+    tbb::parallel_for(0, (int)pairs.size(), 1, [&](int i) {
+        assert(pairs[i].first->id() != pairs[i].second->id());
+        ComputeCollisionHits(pairs[i], &thread_hits.local());
+    });
+
+    std::vector<CollisionHit> hits;
+    thread_hits.combine_each([&](const std::vector<CollisionHit>& local_hits) {
+        hits.insert(hits.end(), local_hits.begin(), local_hits.end());
+    });
+    ApplyNearerHits(&hits);
+}
+
 }  // namespace physic
 
 }  // namespace nextfloor
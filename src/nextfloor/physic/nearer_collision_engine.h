@@ -9,7 +9,10 @@
 
 #include "nextfloor/physic/collision_engine.h"
 
+#include <vector>
+
 #include "nextfloor/mesh/mesh.h"
+#include "nextfloor/physic/collision_pair_cache.h"
 
 namespace nextfloor {
 
@@ -19,29 +22,79 @@ namespace physic {
  *  @class NearerCollisionEngine
  *  @brief Abstract Class who manage collisition computes between 3d models\n
  *  Use Strategy / Template Method Patterns for this abstract class and subclasses,\n
- *  which proposes 2 differents Collision Algorithm: serial, tbb version
+ *  which proposes 4 differents Collision Algorithm: serial, tbb, batch and swept version
  */
 class NearerCollisionEngine : public CollisionEngine {
 
 public:
     static constexpr int kParallellSerial = 1;
     static constexpr int kParallellTbb = 2;
+    static constexpr int kParallellBatch = 3;
+    static constexpr int kParallellSwept = 4;
+
+    static constexpr int kSearchLinear = 1;
+    static constexpr int kSearchBisection = 2;
 
     ~NearerCollisionEngine() override = default;
 
     /* Template Method : Detect if a collision exists between target and obstacle. */
     void DetectCollision(nextfloor::mesh::Mesh* target, nextfloor::mesh::Mesh* obstacle) final;
 
+    /* Template Method : Compute once the collision of a pair, and update the two sides if needed */
+    void DetectCollision(const CollisionPair& pair) final;
+
+    /* Default batch: each pair into a tbb task, then a min reduction of the hits for each mesh */
+    void DetectCollision(const std::vector<CollisionPair>& pairs) override;
+
 protected:
-    NearerCollisionEngine(int granularity) { granularity_ = granularity; }
+    NearerCollisionEngine(int granularity, int search)
+    {
+        granularity_ = granularity;
+        search_ = search;
+    }
 
     NearerCollisionEngine(NearerCollisionEngine&&) = default;
     NearerCollisionEngine& operator=(NearerCollisionEngine&&) = default;
     NearerCollisionEngine(const NearerCollisionEngine&) = delete;
     NearerCollisionEngine& operator=(const NearerCollisionEngine&) = delete;
 
+    typedef struct {
+        nextfloor::mesh::Mesh* target;
+        nextfloor::mesh::Mesh* obstacle;
+        float distance_factor;
+        glm::vec3 move_factor;
+    } CollisionHit;
+
+    /* Compute the pair (if not cached as far), and add a hit for each side to update */
+    void ComputeCollisionHits(const CollisionPair& pair, std::vector<CollisionHit>* hits);
+
+    /**
+     *  Only the nearer hit of each target is applied, lower obstacle id first, from the calling thread only:
+     *  meshes are updated without lock, with the same result at each run
+     */
+    static void ApplyNearerHits(std::vector<CollisionHit>* hits);
+
+    /* 2 objects cannot themselves in collision, but player (camera) */
+    static bool IsSameLastObstacle(nextfloor::mesh::Mesh* target, nextfloor::mesh::Mesh* obstacle)
+    {
+        return !target->IsCamera() && target->IsLastObstacle(obstacle);
+    }
+
+    /**
+     *  Full move is tested first, then bisection down to the first colliding step (about log2(granularity) tests).
+     *  If the full move is free, the swept boxes entry step (and its neighbors) is tested instead, so a fast move
+     *  through a thin obstacle is still found. Same result than linear search while colliding steps are contiguous.
+     */
+    PartialMove ComputeCollisionByBisection(nextfloor::mesh::Mesh* target, nextfloor::mesh::Mesh* obstacle) const;
+
     /* Accuracy (computes count) of NearerCollisionEngine detection */
     int granularity_{16};
+
+    /* Time of impact search, linear or bisection */
+    int search_{kSearchLinear};
+
+    /* Separation of far pairs from previous frames */
+    CollisionPairCache pair_cache_;
 };
 
 }  // namespace physic
@@ -7,27 +7,37 @@
 #include "nextfloor/physic/serial_nearer_collision_engine.h"
 
 #include "nextfloor/mesh/border.h"
+#include "nextfloor/core/common_services.h"
 
 namespace nextfloor {
 
 namespace physic {
 
-SerialNearerCollisionEngine::SerialNearerCollisionEngine(int granularity) : NearerCollisionEngine(granularity) {}
+SerialNearerCollisionEngine::SerialNearerCollisionEngine(int granularity, int search)
+  : NearerCollisionEngine(granularity, search)
+{}
 
 PartialMove SerialNearerCollisionEngine::ComputeCollision(nextfloor::mesh::Mesh* target, nextfloor::mesh::Mesh* obstacle)
 {
+    if (search_ == kSearchBisection) {
+        return ComputeCollisionByBisection(target, obstacle);
+    }
+
     PartialMove default_move{1.0f, glm::vec3(1.0f)};
     nextfloor::mesh::Border* target_border = target->border();
     nextfloor::mesh::Border* obstacle_border = obstacle->border();
+    auto collision_stats = nextfloor::core::CommonServices::getCollisionStats();
 
     for (float factor = 1.0f; factor <= granularity_; factor += 1.0f) {
         float parted_move = factor / granularity_;
         if (target_border->IsObstacleInCollisionAfterPartedMove(*obstacle_border, parted_move)) {
+            collision_stats->AddNarrowEvaluations(static_cast<long long>(factor));
             float factor_move = (factor - 1) / granularity_;
             return PartialMove{factor_move, glm::vec3(-1.0f)};
         }
     }
 
+    collision_stats->AddNarrowEvaluations(granularity_);
     return default_move;
 }
 
@@ -20,7 +20,7 @@ namespace physic {
 class SerialNearerCollisionEngine : public NearerCollisionEngine {
 
 public:
-    SerialNearerCollisionEngine(int granularity);
+    SerialNearerCollisionEngine(int granularity, int search);
     ~SerialNearerCollisionEngine() final = default;
 
     PartialMove ComputeCollision(nextfloor::mesh::Mesh* target, nextfloor::mesh::Mesh* obstacle) final;
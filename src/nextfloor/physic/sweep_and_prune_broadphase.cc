@@ -0,0 +1,259 @@
+/**
+ *  @file sweep_and_prune_broadphase.cc
+ *  @brief SweepAndPruneBroadphase class file
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#include "nextfloor/physic/sweep_and_prune_broadphase.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "nextfloor/physic/swept_box.h"
+#include "nextfloor/core/common_services.h"
+
+namespace nextfloor {
+
+namespace physic {
+
+void SweepAndPruneBroadphase::Update(nextfloor::mesh::Mesh* universe,
+                                     const std::vector<nextfloor::mesh::Mesh*>& moving_objects)
+{
+    Synchronize(universe);
+
+    std::vector<int> moving_proxies;
+    for (auto& mesh : moving_objects) {
+        auto proxy_it = proxy_indexes_.find(mesh);
+        if (proxy_it != proxy_indexes_.end()) {
+            moving_proxies.push_back(proxy_it->second);
+        }
+    }
+
+    /* Former moving objects get back an unswept box, current ones are swept by their movement */
+    for (auto& proxy_index : swept_proxies_) {
+        ComputeProxyBox(proxy_index, false);
+        UpdateEndPointsValues(proxy_index);
+    }
+    for (auto& proxy_index : moving_proxies) {
+        ComputeProxyBox(proxy_index, true);
+        UpdateEndPointsValues(proxy_index);
+    }
+    swept_proxies_ = std::move(moving_proxies);
+
+    for (auto axis = 0; axis < 3; axis++) {
+        SortAxis(axis);
+    }
+
+    ComputeNeighbors();
+}
+
+/**
+ *  Moving neighbors from the overlapping pairs, static ones from the rooms static trees
+ */
+std::vector<nextfloor::mesh::Mesh*> SweepAndPruneBroadphase::FindCollisionNeighbors(nextfloor::mesh::Mesh* pivot) const
+{
+    std::vector<nextfloor::mesh::Mesh*> neighbors = pivot->FindStaticCollisionNeighbors();
+
+    auto neighbors_it = neighbors_.find(pivot);
+    if (neighbors_it != neighbors_.end()) {
+        neighbors.insert(neighbors.end(), neighbors_it->second.begin(), neighbors_it->second.end());
+    }
+    return neighbors;
+}
+
+uint64_t SweepAndPruneBroadphase::PairKey(int first_proxy, int second_proxy)
+{
+    return (static_cast<uint64_t>(std::min(first_proxy, second_proxy)) << 32)
+           | static_cast<uint32_t>(std::max(first_proxy, second_proxy));
+}
+
+void SweepAndPruneBroadphase::Synchronize(nextfloor::mesh::Mesh* universe)
+{
+    /* Meshes tree is unchanged since last frame */
+    if (universe->generation() == generation_) {
+        return;
+    }
+    generation_ = universe->generation();
+
+    /* A move from a room to another does not change leafs. Static meshes have no proxy */
+    std::vector<nextfloor::mesh::Mesh*> meshes = universe->leafs();
+    auto is_static = [](nextfloor::mesh::Mesh* mesh) { return mesh->IsStatic(); };
+    meshes.erase(std::remove_if(meshes.begin(), meshes.end(), is_static), meshes.end());
+    if (!IsSameMeshes(meshes)) {
+        Rebuild(meshes);
+    }
+}
+
+bool SweepAndPruneBroadphase::IsSameMeshes(const std::vector<nextfloor::mesh::Mesh*>& meshes) const
+{
+    if (meshes.size() != proxies_.size()) {
+        return false;
+    }
+
+    return std::all_of(meshes.begin(), meshes.end(), [&](nextfloor::mesh::Mesh* mesh) {
+        return proxy_indexes_.find(mesh) != proxy_indexes_.end();
+    });
+}
+
+void SweepAndPruneBroadphase::Rebuild(const std::vector<nextfloor::mesh::Mesh*>& meshes)
+{
+    proxies_.clear();
+    proxy_indexes_.clear();
+    swept_proxies_.clear();
+    pairs_.clear();
+
+    for (auto& mesh : meshes) {
+        proxy_indexes_[mesh] = proxies_.size();
+        proxies_.push_back(Proxy{mesh});
+        ComputeProxyBox(proxies_.size() - 1, false);
+    }
+
+    for (auto axis = 0; axis < 3; axis++) {
+        axes_[axis].clear();
+        axes_[axis].reserve(2 * proxies_.size());
+        for (auto cnt = 0; cnt < (int)proxies_.size(); cnt++) {
+            axes_[axis].push_back(EndPoint{proxies_[cnt].min[axis], cnt, false});
+            axes_[axis].push_back(EndPoint{proxies_[cnt].max[axis], cnt, true});
+        }
+
+        std::sort(axes_[axis].begin(), axes_[axis].end(), IsBefore);
+        for (auto cnt = 0; cnt < (int)axes_[axis].size(); cnt++) {
+            EndPoint& end_point = axes_[axis][cnt];
+            if (end_point.is_max) {
+                proxies_[end_point.proxy].max_endpoints[axis] = cnt;
+            }
+            else {
+                proxies_[end_point.proxy].min_endpoints[axis] = cnt;
+            }
+        }
+    }
+
+    /* Initial pairs: sweep along x axis and test the other ones. A closed proxy is swapped with the last active one */
+    std::vector<int> active_proxies;
+    std::vector<int> active_slots(proxies_.size(), -1);
+    for (auto& end_point : axes_[0]) {
+        if (end_point.is_max) {
+            int slot = active_slots[end_point.proxy];
+            active_proxies[slot] = active_proxies.back();
+            active_slots[active_proxies[slot]] = slot;
+            active_proxies.pop_back();
+            continue;
+        }
+
+        for (auto& active_proxy : active_proxies) {
+            if (IsOverlap(proxies_[end_point.proxy], proxies_[active_proxy])) {
+                pairs_.insert(PairKey(end_point.proxy, active_proxy));
+            }
+        }
+        active_slots[end_point.proxy] = active_proxies.size();
+        active_proxies.push_back(end_point.proxy);
+    }
+}
+
+void SweepAndPruneBroadphase::ComputeProxyBox(int proxy_index, bool is_moving)
+{
+    Proxy& proxy = proxies_[proxy_index];
+    SweptBox box = MakeBoundingSweptBox(*proxy.mesh->border());
+
+    proxy.min = box.min;
+    proxy.max = box.max;
+    if (is_moving) {
+        proxy.min = glm::min(box.min, box.min + box.movement);
+        proxy.max = glm::max(box.max, box.max + box.movement);
+    }
+}
+
+void SweepAndPruneBroadphase::UpdateEndPointsValues(int proxy_index)
+{
+    Proxy& proxy = proxies_[proxy_index];
+    for (auto axis = 0; axis < 3; axis++) {
+        axes_[axis][proxy.min_endpoints[axis]].value = proxy.min[axis];
+        axes_[axis][proxy.max_endpoints[axis]].value = proxy.max[axis];
+    }
+}
+
+void SweepAndPruneBroadphase::SortAxis(int axis)
+{
+    std::vector<EndPoint>& end_points = axes_[axis];
+
+    /* Nearly sorted from previous frame: few swaps */
+    for (auto cnt = 1; cnt < (int)end_points.size(); cnt++) {
+        for (auto index = cnt; index > 0 && IsBefore(end_points[index], end_points[index - 1]); index--) {
+            SwapEndPoints(axis, index);
+        }
+    }
+}
+
+void SweepAndPruneBroadphase::SwapEndPoints(int axis, int index)
+{
+    std::vector<EndPoint>& end_points = axes_[axis];
+    const EndPoint& moving = end_points[index];
+    const EndPoint& other = end_points[index - 1];
+
+    if (moving.proxy != other.proxy) {
+        /* A min bound goes below a max bound: intervals begin to overlap */
+        if (!moving.is_max && other.is_max) {
+            if (IsOverlap(proxies_[moving.proxy], proxies_[other.proxy])) {
+                pairs_.insert(PairKey(moving.proxy, other.proxy));
+            }
+        }
+
+        /* A max bound goes below a min bound: intervals are now separated */
+        if (moving.is_max && !other.is_max) {
+            pairs_.erase(PairKey(moving.proxy, other.proxy));
+        }
+    }
+
+    std::swap(end_points[index], end_points[index - 1]);
+    for (auto cnt : {index - 1, index}) {
+        EndPoint& end_point = end_points[cnt];
+        if (end_point.is_max) {
+            proxies_[end_point.proxy].max_endpoints[axis] = cnt;
+        }
+        else {
+            proxies_[end_point.proxy].min_endpoints[axis] = cnt;
+        }
+    }
+}
+
+bool SweepAndPruneBroadphase::IsOverlap(const Proxy& first, const Proxy& second) const
+{
+    return first.min.x <= second.max.x && second.min.x <= first.max.x && first.min.y <= second.max.y
+           && second.min.y <= first.max.y && first.min.z <= second.max.z && second.min.z <= first.max.z;
+}
+
+void SweepAndPruneBroadphase::ComputeNeighbors()
+{
+    neighbors_.clear();
+    std::vector<bool> is_moving(proxies_.size(), false);
+    for (auto& proxy_index : swept_proxies_) {
+        is_moving[proxy_index] = true;
+    }
+
+    long long candidates_count = 0;
+    long long eligible_count = 0;
+    for (auto& pair_key : pairs_) {
+        int first_proxy = pair_key >> 32;
+        int second_proxy = pair_key & 0xffffffff;
+        nextfloor::mesh::Mesh* first_mesh = proxies_[first_proxy].mesh;
+        nextfloor::mesh::Mesh* second_mesh = proxies_[second_proxy].mesh;
+
+        candidates_count += is_moving[first_proxy] + is_moving[second_proxy];
+        if (is_moving[first_proxy] && first_mesh->IsNeighborEligibleForCollision(*second_mesh)) {
+            neighbors_[first_mesh].push_back(second_mesh);
+            eligible_count++;
+        }
+        if (is_moving[second_proxy] && second_mesh->IsNeighborEligibleForCollision(*first_mesh)) {
+            neighbors_[second_mesh].push_back(first_mesh);
+            eligible_count++;
+        }
+    }
+
+    using nextfloor::core::CommonServices;
+    CommonServices::getCollisionStats()->AddCandidates(candidates_count);
+    CommonServices::getCollisionStats()->AddEligiblePairs(eligible_count);
+}
+
+}  // namespace physic
+
+}  // namespace nextfloor
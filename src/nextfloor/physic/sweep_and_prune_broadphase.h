@@ -0,0 +1,90 @@
+/**
+ *  @file sweep_and_prune_broadphase.h
+ *  @brief SweepAndPruneBroadphase class header
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_PHYSIC_SWEEPANDPRUNEBROADPHASE_H_
+#define NEXTFLOOR_PHYSIC_SWEEPANDPRUNEBROADPHASE_H_
+
+#include "nextfloor/physic/broadphase.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace nextfloor {
+
+namespace physic {
+
+/**
+ *  @class SweepAndPruneBroadphase
+ *  @brief Persistent sweep and prune: sorted bounds list on each axis, updated with insertion sort.\n
+ *  Overlapping pairs are maintained by the swaps, moving objects boxes are swept by their movement.\n
+ *  Static meshes have no proxy, they are queried into the rooms static trees.
+ */
+class SweepAndPruneBroadphase : public Broadphase {
+
+public:
+    SweepAndPruneBroadphase() = default;
+    ~SweepAndPruneBroadphase() final = default;
+
+    SweepAndPruneBroadphase(SweepAndPruneBroadphase&&) = default;
+    SweepAndPruneBroadphase& operator=(SweepAndPruneBroadphase&&) = default;
+    SweepAndPruneBroadphase(const SweepAndPruneBroadphase&) = delete;
+    SweepAndPruneBroadphase& operator=(const SweepAndPruneBroadphase&) = delete;
+
+    void Update(nextfloor::mesh::Mesh* universe, const std::vector<nextfloor::mesh::Mesh*>& moving_objects) final;
+    std::vector<nextfloor::mesh::Mesh*> FindCollisionNeighbors(nextfloor::mesh::Mesh* pivot) const final;
+
+private:
+    /* Min or max bound of one proxy on one axis */
+    typedef struct {
+        float value;
+        int proxy;
+        bool is_max;
+    } EndPoint;
+
+    typedef struct {
+        nextfloor::mesh::Mesh* mesh;
+        glm::vec3 min;
+        glm::vec3 max;
+        /* Index of min and max endpoints into each axis list */
+        int min_endpoints[3];
+        int max_endpoints[3];
+    } Proxy;
+
+    static bool IsBefore(const EndPoint& first, const EndPoint& second)
+    {
+        return first.value < second.value || (first.value == second.value && !first.is_max && second.is_max);
+    }
+
+    static uint64_t PairKey(int first_proxy, int second_proxy);
+
+    void Synchronize(nextfloor::mesh::Mesh* universe);
+    bool IsSameMeshes(const std::vector<nextfloor::mesh::Mesh*>& meshes) const;
+    void Rebuild(const std::vector<nextfloor::mesh::Mesh*>& meshes);
+    void ComputeProxyBox(int proxy_index, bool is_moving);
+    void UpdateEndPointsValues(int proxy_index);
+    void SortAxis(int axis);
+    void SwapEndPoints(int axis, int index);
+    bool IsOverlap(const Proxy& first, const Proxy& second) const;
+    void ComputeNeighbors();
+
+    std::vector<Proxy> proxies_;
+    std::unordered_map<nextfloor::mesh::Mesh*, int> proxy_indexes_;
+    std::vector<EndPoint> axes_[3];
+    std::unordered_set<uint64_t> pairs_;
+    /* Proxies with a swept box at previous frame */
+    std::vector<int> swept_proxies_;
+    std::unordered_map<nextfloor::mesh::Mesh*, std::vector<nextfloor::mesh::Mesh*>> neighbors_;
+    int generation_{-1};
+};
+
+}  // namespace physic
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_PHYSIC_SWEEPANDPRUNEBROADPHASE_H_
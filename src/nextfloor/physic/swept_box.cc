@@ -0,0 +1,69 @@
+/**
+ *  @file swept_box.cc
+ *  @brief SweptBox helpers file
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#include "nextfloor/physic/swept_box.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace nextfloor {
+
+namespace physic {
+
+SweptBox MakeSweptBox(const nextfloor::mesh::Border& border)
+{
+    glm::vec3 first_point = border.getFirstPoint();
+
+    /* Same bounds than IsObstacleInCollisionAfterPartedMove: first point is the left, top and front side */
+    glm::vec3 min_point(first_point.x,
+                        first_point.y + border.CalculateHeight(),
+                        first_point.z + border.CalculateDepth());
+    glm::vec3 max_point(first_point.x + border.CalculateWidth(), first_point.y, first_point.z);
+    return SweptBox{min_point, max_point, border.movement()};
+}
+
+SweptBox MakeBoundingSweptBox(const nextfloor::mesh::Border& border)
+{
+    glm::vec3 half_dimension = border.dimension() / 2.0f;
+    return SweptBox{border.location() - half_dimension, border.location() + half_dimension, border.movement()};
+}
+
+float ComputeSweptEntryTime(const SweptBox& target, const SweptBox& obstacle)
+{
+    constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+    /* Obstacle is fixed in the target frame */
+    glm::vec3 relative_movement = target.movement - obstacle.movement;
+    float entry_time = -kInfinity;
+    float exit_time = kInfinity;
+
+    for (int axis = 0; axis < 3; axis++) {
+        if (relative_movement[axis] == 0.0f) {
+            /* No move on this axis: boxes must already share the slab */
+            if (target.max[axis] < obstacle.min[axis] || obstacle.max[axis] < target.min[axis]) {
+                return 1.0f;
+            }
+            continue;
+        }
+
+        /* Entry and exit are chosen by move direction, not by order: boxes with min above max stay empty */
+        float first_time = (obstacle.min[axis] - target.max[axis]) / relative_movement[axis];
+        float second_time = (obstacle.max[axis] - target.min[axis]) / relative_movement[axis];
+        bool is_forward = relative_movement[axis] > 0.0f;
+        entry_time = std::max(entry_time, is_forward ? first_time : second_time);
+        exit_time = std::min(exit_time, is_forward ? second_time : first_time);
+    }
+
+    if (entry_time > exit_time || entry_time > 1.0f || exit_time <= 0.0f) {
+        return 1.0f;
+    }
+
+    return std::max(entry_time, 0.0f);
+}
+
+}  // namespace physic
+
+}  // namespace nextfloor
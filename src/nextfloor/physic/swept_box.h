@@ -0,0 +1,48 @@
+/**
+ *  @file swept_box.h
+ *  @brief SweptBox struct and helpers header
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_PHYSIC_SWEPTBOX_H_
+#define NEXTFLOOR_PHYSIC_SWEPTBOX_H_
+
+#include <glm/glm.hpp>
+
+#include "nextfloor/mesh/border.h"
+
+namespace nextfloor {
+
+namespace physic {
+
+/**
+ *  Axis aligned box of a border, with its movement for the current frame (min can be greater than max, see below)
+ */
+typedef struct {
+    glm::vec3 min;
+    glm::vec3 max;
+    glm::vec3 movement;
+} SweptBox;
+
+/**
+ *  Build the axis aligned box compared by the sampled collision test (padded first point, width, height, depth).
+ *  Min is greater than max on an axis thinner than its padding: both tests are then a containment
+ */
+SweptBox MakeSweptBox(const nextfloor::mesh::Border& border);
+
+/**
+ *  Build the full (unpadded) box of the border, conservative bounds for broadphases
+ */
+SweptBox MakeBoundingSweptBox(const nextfloor::mesh::Border& border);
+
+/**
+ *  Slab test between two moving boxes
+ *  @return entry time (as fraction of the move) of target into obstacle, 1.0f if no impact during the move
+ */
+float ComputeSweptEntryTime(const SweptBox& target, const SweptBox& obstacle);
+
+}  // namespace physic
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_PHYSIC_SWEPTBOX_H_
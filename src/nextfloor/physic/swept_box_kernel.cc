@@ -0,0 +1,436 @@
+/**
+ *  @file swept_box_kernel.cc
+ *  @brief Vectorised swept box kernel file
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#include "nextfloor/physic/swept_box_kernel.h"
+
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NEXTFLOOR_SWEPT_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+namespace nextfloor {
+
+namespace physic {
+
+namespace {
+
+constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+SweptBox GetSweptBox(const SweptBoxes& boxes, int index)
+{
+    return SweptBox{glm::vec3(boxes.min_x[index], boxes.min_y[index], boxes.min_z[index]),
+                    glm::vec3(boxes.max_x[index], boxes.max_y[index], boxes.max_z[index]),
+                    glm::vec3(boxes.movement_x[index], boxes.movement_y[index], boxes.movement_z[index])};
+}
+
+void ComputeSweptEntryTimesScalar(const SweptBox& target, const SweptBoxes& obstacles, int first, float* entry_times)
+{
+    int count = obstacles.min_x.size();
+    for (int i = first; i < count; i++) {
+        entry_times[i] = ComputeSweptEntryTime(target, GetSweptBox(obstacles, i));
+    }
+}
+
+void ComputePairwiseSweptEntryTimesScalar(const SweptBoxes& targets,
+                                          const SweptBoxes& obstacles,
+                                          int first,
+                                          int last,
+                                          float* entry_times)
+{
+    for (int i = first; i < last; i++) {
+        entry_times[i] = ComputeSweptEntryTime(GetSweptBox(targets, i), GetSweptBox(obstacles, i));
+    }
+}
+
+#ifdef NEXTFLOOR_SWEPT_KERNEL_X86
+
+/* One axis of the slab test, update entry / exit times and the miss mask */
+__attribute__((target("avx2"))) inline void ComputeSlabAvx2(__m256 tmin,
+                                                             __m256 tmax,
+                                                             __m256 target_movement,
+                                                             const float* obstacle_min,
+                                                             const float* obstacle_max,
+                                                             const float* obstacle_movement,
+                                                             __m256* entry,
+                                                             __m256* exit,
+                                                             __m256* miss)
+{
+    __m256 omin = _mm256_loadu_ps(obstacle_min);
+    __m256 omax = _mm256_loadu_ps(obstacle_max);
+    __m256 movement = _mm256_sub_ps(target_movement, _mm256_loadu_ps(obstacle_movement));
+
+    __m256 first_time = _mm256_div_ps(_mm256_sub_ps(omin, tmax), movement);
+    __m256 second_time = _mm256_div_ps(_mm256_sub_ps(omax, tmin), movement);
+
+    /* No move on this axis: boxes must already share the slab */
+    __m256 is_fixed = _mm256_cmp_ps(movement, _mm256_setzero_ps(), _CMP_EQ_OQ);
+    __m256 is_overlap = _mm256_and_ps(_mm256_cmp_ps(tmax, omin, _CMP_GE_OQ), _mm256_cmp_ps(omax, tmin, _CMP_GE_OQ));
+    *miss = _mm256_or_ps(*miss, _mm256_andnot_ps(is_overlap, is_fixed));
+
+    /* Entry and exit by move direction, as ComputeSweptEntryTime */
+    __m256 is_backward = _mm256_cmp_ps(movement, _mm256_setzero_ps(), _CMP_LT_OQ);
+    __m256 axis_entry = _mm256_blendv_ps(first_time, second_time, is_backward);
+    __m256 axis_exit = _mm256_blendv_ps(second_time, first_time, is_backward);
+    axis_entry = _mm256_blendv_ps(axis_entry, _mm256_set1_ps(-kInfinity), is_fixed);
+    axis_exit = _mm256_blendv_ps(axis_exit, _mm256_set1_ps(kInfinity), is_fixed);
+    *entry = _mm256_max_ps(*entry, axis_entry);
+    *exit = _mm256_min_ps(*exit, axis_exit);
+}
+
+/* Entry time for each lane, 1.0f if no impact during the move */
+__attribute__((target("avx2"))) inline void StoreEntryTimesAvx2(__m256 entry,
+                                                                 __m256 exit,
+                                                                 __m256 miss,
+                                                                 float* entry_times)
+{
+    __m256 one = _mm256_set1_ps(1.0f);
+    __m256 hit = _mm256_andnot_ps(miss, _mm256_cmp_ps(entry, exit, _CMP_LE_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(entry, one, _CMP_LT_OQ));
+    hit = _mm256_and_ps(hit, _mm256_cmp_ps(exit, _mm256_setzero_ps(), _CMP_GT_OQ));
+    __m256 result = _mm256_blendv_ps(one, _mm256_max_ps(entry, _mm256_setzero_ps()), hit);
+    _mm256_storeu_ps(entry_times, result);
+}
+
+__attribute__((target("avx2"))) void ComputeSweptEntryTimesAvx2(const SweptBox& target,
+                                                                 const SweptBoxes& obstacles,
+                                                                 float* entry_times)
+{
+    constexpr int kLanes = 8;
+    int count = obstacles.min_x.size();
+    int i = 0;
+
+    for (; i + kLanes <= count; i += kLanes) {
+        __m256 entry = _mm256_set1_ps(-kInfinity);
+        __m256 exit = _mm256_set1_ps(kInfinity);
+        __m256 miss = _mm256_setzero_ps();
+
+        ComputeSlabAvx2(_mm256_set1_ps(target.min.x),
+                        _mm256_set1_ps(target.max.x),
+                        _mm256_set1_ps(target.movement.x),
+                        &obstacles.min_x[i],
+                        &obstacles.max_x[i],
+                        &obstacles.movement_x[i],
+                        &entry,
+                        &exit,
+                        &miss);
+        ComputeSlabAvx2(_mm256_set1_ps(target.min.y),
+                        _mm256_set1_ps(target.max.y),
+                        _mm256_set1_ps(target.movement.y),
+                        &obstacles.min_y[i],
+                        &obstacles.max_y[i],
+                        &obstacles.movement_y[i],
+                        &entry,
+                        &exit,
+                        &miss);
+        ComputeSlabAvx2(_mm256_set1_ps(target.min.z),
+                        _mm256_set1_ps(target.max.z),
+                        _mm256_set1_ps(target.movement.z),
+                        &obstacles.min_z[i],
+                        &obstacles.max_z[i],
+                        &obstacles.movement_z[i],
+                        &entry,
+                        &exit,
+                        &miss);
+
+        StoreEntryTimesAvx2(entry, exit, miss, &entry_times[i]);
+    }
+
+    ComputeSweptEntryTimesScalar(target, obstacles, i, entry_times);
+}
+
+__attribute__((target("avx2"))) void ComputePairwiseSweptEntryTimesAvx2(const SweptBoxes& targets,
+                                                                         const SweptBoxes& obstacles,
+                                                                         int first,
+                                                                         int last,
+                                                                         float* entry_times)
+{
+    constexpr int kLanes = 8;
+    int i = first;
+
+    for (; i + kLanes <= last; i += kLanes) {
+        __m256 entry = _mm256_set1_ps(-kInfinity);
+        __m256 exit = _mm256_set1_ps(kInfinity);
+        __m256 miss = _mm256_setzero_ps();
+
+        ComputeSlabAvx2(_mm256_loadu_ps(&targets.min_x[i]),
+                        _mm256_loadu_ps(&targets.max_x[i]),
+                        _mm256_loadu_ps(&targets.movement_x[i]),
+                        &obstacles.min_x[i],
+                        &obstacles.max_x[i],
+                        &obstacles.movement_x[i],
+                        &entry,
+                        &exit,
+                        &miss);
+        ComputeSlabAvx2(_mm256_loadu_ps(&targets.min_y[i]),
+                        _mm256_loadu_ps(&targets.max_y[i]),
+                        _mm256_loadu_ps(&targets.movement_y[i]),
+                        &obstacles.min_y[i],
+                        &obstacles.max_y[i],
+                        &obstacles.movement_y[i],
+                        &entry,
+                        &exit,
+                        &miss);
+        ComputeSlabAvx2(_mm256_loadu_ps(&targets.min_z[i]),
+                        _mm256_loadu_ps(&targets.max_z[i]),
+                        _mm256_loadu_ps(&targets.movement_z[i]),
+                        &obstacles.min_z[i],
+                        &obstacles.max_z[i],
+                        &obstacles.movement_z[i],
+                        &entry,
+                        &exit,
+                        &miss);
+
+        StoreEntryTimesAvx2(entry, exit, miss, &entry_times[i]);
+    }
+
+    ComputePairwiseSweptEntryTimesScalar(targets, obstacles, i, last, entry_times);
+}
+
+/* SSE2 is always there on x86_64, so selects with and / andnot / or instead of blendv */
+inline __m128 SelectSse(__m128 mask, __m128 if_true, __m128 if_false)
+{
+    return _mm_or_ps(_mm_and_ps(mask, if_true), _mm_andnot_ps(mask, if_false));
+}
+
+inline void ComputeSlabSse(__m128 tmin,
+                           __m128 tmax,
+                           __m128 target_movement,
+                           const float* obstacle_min,
+                           const float* obstacle_max,
+                           const float* obstacle_movement,
+                           __m128* entry,
+                           __m128* exit,
+                           __m128* miss)
+{
+    __m128 omin = _mm_loadu_ps(obstacle_min);
+    __m128 omax = _mm_loadu_ps(obstacle_max);
+    __m128 movement = _mm_sub_ps(target_movement, _mm_loadu_ps(obstacle_movement));
+
+    __m128 first_time = _mm_div_ps(_mm_sub_ps(omin, tmax), movement);
+    __m128 second_time = _mm_div_ps(_mm_sub_ps(omax, tmin), movement);
+
+    __m128 is_fixed = _mm_cmpeq_ps(movement, _mm_setzero_ps());
+    __m128 is_overlap = _mm_and_ps(_mm_cmpge_ps(tmax, omin), _mm_cmpge_ps(omax, tmin));
+    *miss = _mm_or_ps(*miss, _mm_andnot_ps(is_overlap, is_fixed));
+
+    /* Entry and exit by move direction, as ComputeSweptEntryTime */
+    __m128 is_backward = _mm_cmplt_ps(movement, _mm_setzero_ps());
+    __m128 axis_entry = SelectSse(is_backward, second_time, first_time);
+    __m128 axis_exit = SelectSse(is_backward, first_time, second_time);
+    axis_entry = SelectSse(is_fixed, _mm_set1_ps(-kInfinity), axis_entry);
+    axis_exit = SelectSse(is_fixed, _mm_set1_ps(kInfinity), axis_exit);
+    *entry = _mm_max_ps(*entry, axis_entry);
+    *exit = _mm_min_ps(*exit, axis_exit);
+}
+
+inline void StoreEntryTimesSse(__m128 entry, __m128 exit, __m128 miss, float* entry_times)
+{
+    __m128 one = _mm_set1_ps(1.0f);
+    __m128 hit = _mm_andnot_ps(miss, _mm_cmple_ps(entry, exit));
+    hit = _mm_and_ps(hit, _mm_cmplt_ps(entry, one));
+    hit = _mm_and_ps(hit, _mm_cmpgt_ps(exit, _mm_setzero_ps()));
+    __m128 result = SelectSse(hit, _mm_max_ps(entry, _mm_setzero_ps()), one);
+    _mm_storeu_ps(entry_times, result);
+}
+
+void ComputeSweptEntryTimesSse(const SweptBox& target, const SweptBoxes& obstacles, float* entry_times)
+{
+    constexpr int kLanes = 4;
+    int count = obstacles.min_x.size();
+    int i = 0;
+
+    for (; i + kLanes <= count; i += kLanes) {
+        __m128 entry = _mm_set1_ps(-kInfinity);
+        __m128 exit = _mm_set1_ps(kInfinity);
+        __m128 miss = _mm_setzero_ps();
+
+        ComputeSlabSse(_mm_set1_ps(target.min.x),
+                       _mm_set1_ps(target.max.x),
+                       _mm_set1_ps(target.movement.x),
+                       &obstacles.min_x[i],
+                       &obstacles.max_x[i],
+                       &obstacles.movement_x[i],
+                       &entry,
+                       &exit,
+                       &miss);
+        ComputeSlabSse(_mm_set1_ps(target.min.y),
+                       _mm_set1_ps(target.max.y),
+                       _mm_set1_ps(target.movement.y),
+                       &obstacles.min_y[i],
+                       &obstacles.max_y[i],
+                       &obstacles.movement_y[i],
+                       &entry,
+                       &exit,
+                       &miss);
+        ComputeSlabSse(_mm_set1_ps(target.min.z),
+                       _mm_set1_ps(target.max.z),
+                       _mm_set1_ps(target.movement.z),
+                       &obstacles.min_z[i],
+                       &obstacles.max_z[i],
+                       &obstacles.movement_z[i],
+                       &entry,
+                       &exit,
+                       &miss);
+
+        StoreEntryTimesSse(entry, exit, miss, &entry_times[i]);
+    }
+
+    ComputeSweptEntryTimesScalar(target, obstacles, i, entry_times);
+}
+
+void ComputePairwiseSweptEntryTimesSse(const SweptBoxes& targets,
+                                       const SweptBoxes& obstacles,
+                                       int first,
+                                       int last,
+                                       float* entry_times)
+{
+    constexpr int kLanes = 4;
+    int i = first;
+
+    for (; i + kLanes <= last; i += kLanes) {
+        __m128 entry = _mm_set1_ps(-kInfinity);
+        __m128 exit = _mm_set1_ps(kInfinity);
+        __m128 miss = _mm_setzero_ps();
+
+        ComputeSlabSse(_mm_loadu_ps(&targets.min_x[i]),
+                       _mm_loadu_ps(&targets.max_x[i]),
+                       _mm_loadu_ps(&targets.movement_x[i]),
+                       &obstacles.min_x[i],
+                       &obstacles.max_x[i],
+                       &obstacles.movement_x[i],
+                       &entry,
+                       &exit,
+                       &miss);
+        ComputeSlabSse(_mm_loadu_ps(&targets.min_y[i]),
+                       _mm_loadu_ps(&targets.max_y[i]),
+                       _mm_loadu_ps(&targets.movement_y[i]),
+                       &obstacles.min_y[i],
+                       &obstacles.max_y[i],
+                       &obstacles.movement_y[i],
+                       &entry,
+                       &exit,
+                       &miss);
+        ComputeSlabSse(_mm_loadu_ps(&targets.min_z[i]),
+                       _mm_loadu_ps(&targets.max_z[i]),
+                       _mm_loadu_ps(&targets.movement_z[i]),
+                       &obstacles.min_z[i],
+                       &obstacles.max_z[i],
+                       &obstacles.movement_z[i],
+                       &entry,
+                       &exit,
+                       &miss);
+
+        StoreEntryTimesSse(entry, exit, miss, &entry_times[i]);
+    }
+
+    ComputePairwiseSweptEntryTimesScalar(targets, obstacles, i, last, entry_times);
+}
+
+#endif  // NEXTFLOOR_SWEPT_KERNEL_X86
+
+typedef void (*SweptEntryTimesKernel)(const SweptBox&, const SweptBoxes&, float*);
+typedef void (*PairwiseSweptEntryTimesKernel)(const SweptBoxes&, const SweptBoxes&, int, int, float*);
+
+SweptEntryTimesKernel SelectSweptEntryTimesKernel()
+{
+#ifdef NEXTFLOOR_SWEPT_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return ComputeSweptEntryTimesAvx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return ComputeSweptEntryTimesSse;
+    }
+#endif
+    return [](const SweptBox& target, const SweptBoxes& obstacles, float* entry_times) {
+        ComputeSweptEntryTimesScalar(target, obstacles, 0, entry_times);
+    };
+}
+
+PairwiseSweptEntryTimesKernel SelectPairwiseSweptEntryTimesKernel()
+{
+#ifdef NEXTFLOOR_SWEPT_KERNEL_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return ComputePairwiseSweptEntryTimesAvx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return ComputePairwiseSweptEntryTimesSse;
+    }
+#endif
+    return ComputePairwiseSweptEntryTimesScalar;
+}
+
+}  // namespace
+
+void ClearSweptBoxes(SweptBoxes* boxes, int count)
+{
+    for (auto* component : {&boxes->min_x, &boxes->min_y, &boxes->min_z, &boxes->max_x, &boxes->max_y, &boxes->max_z,
+                            &boxes->movement_x, &boxes->movement_y, &boxes->movement_z}) {
+        component->clear();
+        component->reserve(count);
+    }
+}
+
+void ResizeSweptBoxes(SweptBoxes* boxes, int count)
+{
+    for (auto* component : {&boxes->min_x, &boxes->min_y, &boxes->min_z, &boxes->max_x, &boxes->max_y, &boxes->max_z,
+                            &boxes->movement_x, &boxes->movement_y, &boxes->movement_z}) {
+        component->resize(count);
+    }
+}
+
+void SetSweptBox(SweptBoxes* boxes, int index, const SweptBox& box)
+{
+    boxes->min_x[index] = box.min.x;
+    boxes->min_y[index] = box.min.y;
+    boxes->min_z[index] = box.min.z;
+    boxes->max_x[index] = box.max.x;
+    boxes->max_y[index] = box.max.y;
+    boxes->max_z[index] = box.max.z;
+    boxes->movement_x[index] = box.movement.x;
+    boxes->movement_y[index] = box.movement.y;
+    boxes->movement_z[index] = box.movement.z;
+}
+
+void AddSweptBox(SweptBoxes* boxes, const SweptBox& box)
+{
+    boxes->min_x.push_back(box.min.x);
+    boxes->min_y.push_back(box.min.y);
+    boxes->min_z.push_back(box.min.z);
+    boxes->max_x.push_back(box.max.x);
+    boxes->max_y.push_back(box.max.y);
+    boxes->max_z.push_back(box.max.z);
+    boxes->movement_x.push_back(box.movement.x);
+    boxes->movement_y.push_back(box.movement.y);
+    boxes->movement_z.push_back(box.movement.z);
+}
+
+void ComputeSweptEntryTimes(const SweptBox& target, const SweptBoxes& obstacles, std::vector<float>* entry_times)
+{
+    /* Cpu features are checked once, at first call */
+    static const SweptEntryTimesKernel kernel = SelectSweptEntryTimesKernel();
+
+    entry_times->resize(obstacles.min_x.size());
+    kernel(target, obstacles, entry_times->data());
+}
+
+void ComputePairwiseSweptEntryTimes(const SweptBoxes& targets,
+                                    const SweptBoxes& obstacles,
+                                    int first,
+                                    int last,
+                                    float* entry_times)
+{
+    static const PairwiseSweptEntryTimesKernel kernel = SelectPairwiseSweptEntryTimesKernel();
+
+    kernel(targets, obstacles, first, last, entry_times);
+}
+
+}  // namespace physic
+
+}  // namespace nextfloor
@@ -0,0 +1,68 @@
+/**
+ *  @file swept_box_kernel.h
+ *  @brief Vectorised swept box kernel header
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_PHYSIC_SWEPTBOXKERNEL_H_
+#define NEXTFLOOR_PHYSIC_SWEPTBOXKERNEL_H_
+
+#include <vector>
+
+#include "nextfloor/physic/swept_box.h"
+
+namespace nextfloor {
+
+namespace physic {
+
+/**
+ *  Structure of arrays of swept boxes, one float per box for each component
+ */
+typedef struct {
+    std::vector<float> min_x, min_y, min_z;
+    std::vector<float> max_x, max_y, max_z;
+    std::vector<float> movement_x, movement_y, movement_z;
+} SweptBoxes;
+
+/**
+ *  Reset and reserve room for count boxes
+ */
+void ClearSweptBoxes(SweptBoxes* boxes, int count);
+
+/**
+ *  Set count boxes, to be filled by index (from parallel tasks)
+ */
+void ResizeSweptBoxes(SweptBoxes* boxes, int count);
+
+/**
+ *  Overwrite the box at index
+ */
+void SetSweptBox(SweptBoxes* boxes, int index, const SweptBox& box);
+
+/**
+ *  Append one box at the end of the arrays
+ */
+void AddSweptBox(SweptBoxes* boxes, const SweptBox& box);
+
+/**
+ *  Slab test of target against each obstacle: 8 (avx2) or 4 (sse) lanes at once, scalar for others cpus.
+ *  Same result than ComputeSweptEntryTime for each obstacle.
+ *  @param entry_times output, one entry time per obstacle (1.0f if no impact)
+ */
+void ComputeSweptEntryTimes(const SweptBox& target, const SweptBoxes& obstacles, std::vector<float>* entry_times);
+
+/**
+ *  Slab test of the pairs (targets[i], obstacles[i]) for i into [first, last), same lanes than above.
+ *  @param entry_times output, indexed like the boxes, so ranges can be computed by concurrent tasks
+ */
+void ComputePairwiseSweptEntryTimes(const SweptBoxes& targets,
+                                    const SweptBoxes& obstacles,
+                                    int first,
+                                    int last,
+                                    float* entry_times);
+
+}  // namespace physic
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_PHYSIC_SWEPTBOXKERNEL_H_
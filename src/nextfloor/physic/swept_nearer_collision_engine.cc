@@ -0,0 +1,106 @@
+/**
+ *  @file swept_nearer_collision_engine.cc
+ *  @brief Swept AABB version for CollisionEngine
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#include "nextfloor/physic/swept_nearer_collision_engine.h"
+
+#include <tbb/tbb.h>
+#include <cassert>
+
+#include "nextfloor/mesh/border.h"
+#include "nextfloor/physic/swept_box.h"
+#include "nextfloor/physic/swept_box_kernel.h"
+#include "nextfloor/core/common_services.h"
+
+namespace nextfloor {
+
+namespace physic {
+
+SweptNearerCollisionEngine::SweptNearerCollisionEngine(int granularity, int search)
+  : NearerCollisionEngine(granularity, search)
+{}
+
+void SweptNearerCollisionEngine::DetectCollision(const std::vector<CollisionPair>& pairs)
+{
+    pair_cache_.ClearIfFull();
+
+    /* Pairs are sorted by first mesh: one range for each first mesh */
+    std::vector<int> range_starts;
+    for (int cnt = 0; cnt < (int)pairs.size(); cnt++) {
+        if (cnt == 0 || pairs[cnt].first != pairs[cnt - 1].first) {
+            range_starts.push_back(cnt);
+        }
+    }
+    range_starts.push_back(pairs.size());
+
+    tbb::combinable<std::vector<CollisionHit>> thread_hits;
+    tbb::parallel_for(0, (int)range_starts.size() - 1, 1, [&](int i) {
+        ComputeCollisionHitsOfFirstMesh(pairs, range_starts[i], range_starts[i + 1], &thread_hits.local());
+    });
+
+    std::vector<CollisionHit> hits;
+    thread_hits.combine_each([&](const std::vector<CollisionHit>& local_hits) {
+        hits.insert(hits.end(), local_hits.begin(), local_hits.end());
+    });
+    ApplyNearerHits(&hits);
+}
+
+void SweptNearerCollisionEngine::ComputeCollisionHitsOfFirstMesh(const std::vector<CollisionPair>& pairs,
+                                                                 int first_pair,
+                                                                 int last_pair,
+                                                                 std::vector<CollisionHit>* hits)
+{
+    nextfloor::mesh::Mesh* target = pairs[first_pair].first;
+    std::vector<CollisionPair> tested_pairs;
+    tested_pairs.reserve(last_pair - first_pair);
+    SweptBoxes obstacle_boxes;
+    ClearSweptBoxes(&obstacle_boxes, last_pair - first_pair);
+
+    for (auto cnt = first_pair; cnt < last_pair; cnt++) {
+        CollisionPair pair = pairs[cnt];
+        assert(pair.first == target && target->id() != pair.second->id());
+        pair.is_first_updated = pair.is_first_updated && !IsSameLastObstacle(target, pair.second);
+        pair.is_second_updated = pair.is_second_updated && !IsSameLastObstacle(pair.second, target);
+        if ((pair.is_first_updated || pair.is_second_updated) && !pair_cache_.IsSeparated(target, pair.second)) {
+            tested_pairs.push_back(pair);
+            AddSweptBox(&obstacle_boxes, MakeSweptBox(*pair.second->border()));
+        }
+    }
+
+    std::vector<float> entry_times;
+    ComputeSweptEntryTimes(MakeSweptBox(*target->border()), obstacle_boxes, &entry_times);
+    nextfloor::core::CommonServices::getCollisionStats()->AddNarrowEvaluations(entry_times.size());
+
+    for (int i = 0; i < (int)entry_times.size(); i++) {
+        pair_cache_.Update(target, tested_pairs[i].second, entry_times[i] < 1.0f);
+        if (entry_times[i] >= 1.0f) {
+            continue;
+        }
+
+        if (tested_pairs[i].is_first_updated) {
+            hits->push_back(CollisionHit{target, tested_pairs[i].second, entry_times[i], glm::vec3(-1.0f)});
+        }
+        if (tested_pairs[i].is_second_updated) {
+            hits->push_back(CollisionHit{tested_pairs[i].second, target, entry_times[i], glm::vec3(-1.0f)});
+        }
+    }
+}
+
+PartialMove SweptNearerCollisionEngine::ComputeCollision(nextfloor::mesh::Mesh* target, nextfloor::mesh::Mesh* obstacle)
+{
+    PartialMove default_move{1.0f, glm::vec3(1.0f)};
+
+    nextfloor::core::CommonServices::getCollisionStats()->AddNarrowEvaluations(1);
+    float entry_time = ComputeSweptEntryTime(MakeSweptBox(*target->border()), MakeSweptBox(*obstacle->border()));
+    if (entry_time < 1.0f) {
+        return PartialMove{entry_time, glm::vec3(-1.0f)};
+    }
+
+    return default_move;
+}
+
+}  // namespace physic
+
+}  // namespace nextfloor
@@ -0,0 +1,45 @@
+/**
+ *  @file swept_nearer_collision_engine.h
+ *  @brief SweptNearerCollisionEngine class header
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_PHYSIC_SWEPTNEARERCOLLISIONENGINE_H_
+#define NEXTFLOOR_PHYSIC_SWEPTNEARERCOLLISIONENGINE_H_
+
+#include "nextfloor/physic/nearer_collision_engine.h"
+
+namespace nextfloor {
+
+namespace physic {
+
+/**
+ *  @class SweptNearerCollisionEngine
+ *  @brief Implements analytic swept AABB (slab test) algorithm for collision computes\n
+ *  One evaluation per pair, granularity and search mode have no effect on result
+ */
+class SweptNearerCollisionEngine : public NearerCollisionEngine {
+
+public:
+    SweptNearerCollisionEngine(int granularity, int search);
+    ~SweptNearerCollisionEngine() final = default;
+
+    using NearerCollisionEngine::DetectCollision;
+
+    /* Vectorised batch: pairs sharing the same first mesh into one kernel call */
+    void DetectCollision(const std::vector<CollisionPair>& pairs) final;
+
+    PartialMove ComputeCollision(nextfloor::mesh::Mesh* target, nextfloor::mesh::Mesh* obstacle) final;
+
+private:
+    void ComputeCollisionHitsOfFirstMesh(const std::vector<CollisionPair>& pairs,
+                                         int first_pair,
+                                         int last_pair,
+                                         std::vector<CollisionHit>* hits);
+};
+
+}  // namespace physic
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_PHYSIC_SWEPTNEARERCOLLISIONENGINE_H_
@@ -7,36 +7,55 @@
 #include "nextfloor/physic/tbb_nearer_collision_engine.h"
 
 #include <tbb/tbb.h>
-#include <mutex>
+#include <algorithm>
 
 #include "nextfloor/mesh/border.h"
+#include "nextfloor/core/common_services.h"
 
 namespace nextfloor {
 
 namespace physic {
 
-TbbNearerCollisionEngine::TbbNearerCollisionEngine(int granularity) : NearerCollisionEngine(granularity) {}
+TbbNearerCollisionEngine::TbbNearerCollisionEngine(int granularity, int search)
+  : NearerCollisionEngine(granularity, search)
+{}
 
 PartialMove TbbNearerCollisionEngine::ComputeCollision(nextfloor::mesh::Mesh* target, nextfloor::mesh::Mesh* obstacle)
 {
-    PartialMove target_move{1.0f, glm::vec3(1.0f)};
+    /* Bisection is sequential by nature */
+    if (search_ == kSearchBisection) {
+        return ComputeCollisionByBisection(target, obstacle);
+    }
+
+    PartialMove default_move{1.0f, glm::vec3(1.0f)};
     nextfloor::mesh::Border* target_border = target->border();
     nextfloor::mesh::Border* obstacle_border = obstacle->border();
-    std::mutex distance_mutex;
-
-    tbb::parallel_for(1, (granularity_ + 1), 1, [&](int factor) {
-        float parted_move = static_cast<float>(factor) / granularity_;
-        if (target_border->IsObstacleInCollisionAfterPartedMove(*obstacle_border, parted_move)) {
-            float test_collision = static_cast<float>(factor - 1) / granularity_;
-
-            std::scoped_lock lock_map(distance_mutex);
-            if (test_collision < target_move.distance_factor) {
-                target_move = {test_collision, glm::vec3(-1.0f)};
-            }
-        }
-    });
-
-    return target_move;
+    const int no_collision_factor = granularity_ + 1;
+
+    /* Min reduction of the first colliding step, each range stops at its first hit */
+    int collision_factor = tbb::parallel_reduce(
+      tbb::blocked_range<int>(1, granularity_ + 1),
+      no_collision_factor,
+      [&](const tbb::blocked_range<int>& factors, int nearer_factor) {
+          auto factor = factors.begin();
+          for (; factor != factors.end() && factor < nearer_factor; factor++) {
+              float parted_move = static_cast<float>(factor) / granularity_;
+              if (target_border->IsObstacleInCollisionAfterPartedMove(*obstacle_border, parted_move)) {
+                  nearer_factor = factor;
+                  factor++;
+                  break;
+              }
+          }
+          nextfloor::core::CommonServices::getCollisionStats()->AddNarrowEvaluations(factor - factors.begin());
+          return nearer_factor;
+      },
+      [](int factor1, int factor2) { return std::min(factor1, factor2); });
+
+    if (collision_factor == no_collision_factor) {
+        return default_move;
+    }
+
+    return PartialMove{static_cast<float>(collision_factor - 1) / granularity_, glm::vec3(-1.0f)};
 }
 
 }  // namespace physic
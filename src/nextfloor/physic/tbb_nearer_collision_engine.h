@@ -20,7 +20,7 @@ namespace physic {
 class TbbNearerCollisionEngine : public NearerCollisionEngine {
 
 public:
-    TbbNearerCollisionEngine(int granularity);
+    TbbNearerCollisionEngine(int granularity, int search);
     ~TbbNearerCollisionEngine() final = default;
 
     PartialMove ComputeCollision(nextfloor::mesh::Mesh* target, nextfloor::mesh::Mesh* obstacle) final;
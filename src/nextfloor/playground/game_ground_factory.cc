@@ -9,6 +9,7 @@
 
 #include <glm/glm.hpp>
 #include <memory>
+#include <vector>
 
 #include "nextfloor/mesh/border.h"
 #include "nextfloor/playground/grid.h"
@@ -45,7 +46,12 @@ std::unique_ptr<Ground> GameGroundFactory::MakeUniverse(std::vector<std::unique_
 std::unique_ptr<Ground> GameGroundFactory::MakeRoom(const glm::vec3& location,
                                                     std::vector<std::unique_ptr<nextfloor::mesh::DynamicMesh>> objects) const
 {
-    std::unique_ptr<Grid> grid = grid_factory_->MakeRoomGrid(location);
+    std::vector<nextfloor::mesh::Mesh*> meshes;
+    for (auto& object : objects) {
+        meshes.push_back(object.get());
+    }
+
+    std::unique_ptr<Grid> grid = grid_factory_->MakeRoomGrid(location, meshes);
     std::unique_ptr<nextfloor::mesh::Border> border = border_factory_->MakeBorder(location, grid->scale());
 
     std::vector<std::unique_ptr<Wall>> walls;
@@ -56,7 +62,9 @@ std::unique_ptr<Ground> GameGroundFactory::MakeRoom(const glm::vec3& location,
     walls.push_back(MakeFloor(grid->CalculateBottomSideLocation(), grid->CalculateBottomSideBorderScale()));
     walls.push_back(MakeRoof(grid->CalculateTopSideLocation(), grid->CalculateTopSideBorderScale()));
 
-    return std::make_unique<Room>(std::move(grid), std::move(border), std::move(walls), std::move(objects));
+    std::unique_ptr<MeshTree> static_tree = grid_factory_->MakeMeshTree();
+    return std::make_unique<Room>(
+      std::move(grid), std::move(static_tree), std::move(border), std::move(walls), std::move(objects));
 }
 
 std::unique_ptr<Wall> GameGroundFactory::MakeFrontWall(const glm::vec3& location, const glm::vec3& scale) const
@@ -7,7 +7,9 @@
 #ifndef NEXTFLOOR_PLAYGROUND_GRID_H_
 #define NEXTFLOOR_PLAYGROUND_GRID_H_
 
+#include <functional>
 #include <memory>
+#include <vector>
 #include <glm/glm.hpp>
 
 #include "nextfloor/mesh/mesh.h"
@@ -23,6 +25,30 @@ namespace playground {
 class Grid {
 
 public:
+    /* Nearer mesh crossed by a ray (nullptr if none) and its distance from the ray origin */
+    typedef struct {
+        nextfloor::mesh::Mesh* mesh;
+        float distance;
+    } RayHit;
+
+    /* Returns false for meshes ignored by a query, an empty filter keeps all meshes */
+    using MeshFilter = std::function<bool(const nextfloor::mesh::Mesh&)>;
+
+    static constexpr int kLoadHistogramSize = 8;
+
+    /*
+     *  Occupancy snapshot: cells by occupants count (last slot for larger loads), placements (sum of the cells
+     *  occupants) and boxes scanned by one neighbors query of each placed object (query fan-out)
+     */
+    typedef struct {
+        long long load_histogram[kLoadHistogramSize];
+        long long cells_count;
+        long long max_load;
+        long long objects_count;
+        long long placements;
+        long long query_boxes;
+    } OccupancyStats;
+
     virtual ~Grid() = default;
 
     virtual bool IsPositionEmpty(const glm::ivec3& coords) const = 0;
@@ -35,14 +61,53 @@ public:
     virtual bool IsPositionFilled(const glm::ivec3& coords) const = 0;
 
     virtual std::vector<nextfloor::mesh::Mesh*> FindCollisionNeighbors(const glm::vec3& coord) const = 0;
+    virtual void FindCollisionNeighbors(const glm::vec3& coord,
+                                        std::vector<nextfloor::mesh::Mesh*>* neighbors) const = 0;
+    virtual void FindCollisionNeighborsOf(const nextfloor::mesh::Mesh& target,
+                                          std::vector<nextfloor::mesh::Mesh*>* neighbors) const = 0;
+    virtual void FindCollisionNeighbors(const glm::vec3& min_point,
+                                        const glm::vec3& max_point,
+                                        std::vector<nextfloor::mesh::Mesh*>* neighbors) const = 0;
+
+    /**
+     *  Spatial queries on the meshes bounds, each found mesh is appended once to the caller buffer.
+     *  Grid occupants only: static meshes of a ground are into its static tree, queried through Ground
+     */
+    virtual void QueryBox(const glm::vec3& min_point,
+                          const glm::vec3& max_point,
+                          std::vector<nextfloor::mesh::Mesh*>* meshes) const = 0;
+    virtual void QuerySphere(const glm::vec3& center,
+                             float radius,
+                             std::vector<nextfloor::mesh::Mesh*>* meshes) const = 0;
+    /* Nearer first, distance from point to the mesh bounds */
+    virtual void QueryKNearest(const glm::vec3& point, int k, std::vector<nextfloor::mesh::Mesh*>* meshes) const = 0;
+
+    virtual RayHit RayCast(const glm::vec3& origin,
+                           const glm::vec3& direction,
+                           float max_distance,
+                           const MeshFilter& filter) const = 0;
+    virtual RayHit SegmentCast(const glm::vec3& start_point,
+                               const glm::vec3& end_point,
+                               const MeshFilter& filter) const = 0;
     virtual glm::vec3 CalculateFirstPointInGrid() const = 0;
     virtual glm::vec3 CalculateAbsoluteCoordinates(const glm::ivec3& coords) const = 0;
 
     virtual void AddItem(nextfloor::mesh::Mesh* object) = 0;
+    virtual void UpdateItem(nextfloor::mesh::Mesh* object) = 0;
     virtual void RemoveMesh(nextfloor::mesh::Mesh* object) = 0;
     virtual bool IsInside(const glm::vec3& location_object) const = 0;
 
+    /**
+     *  Two levels occupancy: a child grid (room) sets the bit of its location box into its parent grid (universe)
+     *  while it has occupants, one child grid by parent box. Empty child grids are skipped before being read.
+     *  Grids without occupancy bits keep their child grids as occupied
+     */
+    virtual void set_parent_grid(Grid* parent_grid) = 0;
+    virtual void SetChildGridOccupancy(const glm::vec3& child_location, bool is_occupied) = 0;
+    virtual bool IsChildGridOccupied(const glm::vec3& child_location) const = 0;
+
     virtual void DisplayGrid() const = 0;
+    virtual OccupancyStats CalculateOccupancyStats() const = 0;
     virtual void ResetGrid() = 0;
 
     virtual glm::vec3 CalculateFrontSideLocation() const = 0;
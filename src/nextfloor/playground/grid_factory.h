@@ -8,9 +8,12 @@
 #define NEXTFLOOR_PLAYGROUND_GRIDFACTORY_H_
 
 #include <memory>
+#include <vector>
 #include <glm/glm.hpp>
 
 #include "nextfloor/playground/grid.h"
+#include "nextfloor/playground/mesh_tree.h"
+#include "nextfloor/mesh/mesh.h"
 
 namespace nextfloor {
 
@@ -23,10 +26,20 @@ namespace playground {
 class GridFactory {
 
 public:
+    static constexpr int kGridStorageNested = 1;
+    static constexpr int kGridStorageFlat = 2;
+    static constexpr int kGridStorageHash = 3;
+    static constexpr int kGridPlacementOverlap = 1;
+    static constexpr int kGridPlacementLoose = 2;
+
     virtual ~GridFactory() = default;
 
     virtual std::unique_ptr<Grid> MakeUniverseGrid(const glm::vec3& location) const = 0;
     virtual std::unique_ptr<Grid> MakeRoomGrid(const glm::vec3& location) const = 0;
+    /* Boxes can be tuned (if enabled) for the meshes to place into the room */
+    virtual std::unique_ptr<Grid> MakeRoomGrid(const glm::vec3& location,
+                                               const std::vector<nextfloor::mesh::Mesh*>& meshes) const = 0;
+    virtual std::unique_ptr<MeshTree> MakeMeshTree() const = 0;
 };
 
 }  // namespace playground
@@ -7,11 +7,13 @@
 #include "nextfloor/playground/ground.h"
 
 #include <tbb/tbb.h>
+#include <algorithm>
 #include <mutex>
 #include <vector>
 #include <glm/glm.hpp>
 
 #include "nextfloor/mesh/grid_box.h"
+#include "nextfloor/core/common_services.h"
 
 namespace nextfloor {
 
@@ -19,53 +21,278 @@ namespace playground {
 
 std::vector<nextfloor::mesh::Mesh*> Ground::FindCollisionNeighborsOf(const nextfloor::mesh::Mesh& target) const
 {
+    glm::vec3 min_point, max_point;
+    CalculateSweptBounds(target, &min_point, &max_point);
+
+    /* Each mesh is in one grid only: grids append each neighbor once, only static tree ones have to be merged */
     std::vector<nextfloor::mesh::Mesh*> all_neighbors(0);
-    for (glm::ivec3& coord : target.coords()) {
-        std::vector<nextfloor::mesh::Mesh*> neighbors = grid()->FindCollisionNeighbors(coord);
+    grid()->FindCollisionNeighborsOf(target, &all_neighbors);
+    FindHaloNeighbors(min_point, max_point, &all_neighbors);
+
+    if (static_tree_ != nullptr) {
+        std::vector<nextfloor::mesh::Mesh*> neighbors = static_tree_->FindCollisionNeighbors(min_point, max_point);
         all_neighbors.insert(all_neighbors.end(), neighbors.begin(), neighbors.end());
+
+        sort(all_neighbors.begin(), all_neighbors.end());
+        all_neighbors.erase(unique(all_neighbors.begin(), all_neighbors.end()), all_neighbors.end());
     }
 
-    sort(all_neighbors.begin(), all_neighbors.end());
-    all_neighbors.erase(unique(all_neighbors.begin(), all_neighbors.end()), all_neighbors.end());
-    all_neighbors.erase(std::remove(all_neighbors.begin(), all_neighbors.end(), &target));
+    all_neighbors.erase(std::remove(all_neighbors.begin(), all_neighbors.end(), &target), all_neighbors.end());
 
-    std::mutex neighbors_mutex;
-    std::vector<nextfloor::mesh::Mesh*> collision_neighbors(0);
+    return KeepEligibleNeighbors(target, all_neighbors);
+}
 
+/**
+ *  Static trees only (this ground and adjacent ones), moving neighbors are tracked by the caller
+ */
+std::vector<nextfloor::mesh::Mesh*> Ground::FindStaticNeighborsOf(const nextfloor::mesh::Mesh& target) const
+{
+    glm::vec3 min_point, max_point;
+    CalculateSweptBounds(target, &min_point, &max_point);
+
+    std::vector<nextfloor::mesh::Mesh*> static_neighbors(0);
+    if (static_tree_ != nullptr) {
+        static_neighbors = static_tree_->FindCollisionNeighbors(min_point, max_point);
+    }
+    FindAdjacentStaticNeighbors(min_point, max_point, &static_neighbors);
+
+    return KeepEligibleNeighbors(target, static_neighbors);
+}
+
+/**
+ *  Target bounds, swept by its movement
+ */
+void Ground::CalculateSweptBounds(const nextfloor::mesh::Mesh& target, glm::vec3* min_point, glm::vec3* max_point) const
+{
+    glm::vec3 half_dimension = target.dimension() / 2.0f;
+    *min_point = target.location() - half_dimension;
+    *max_point = target.location() + half_dimension;
+    *min_point = glm::min(*min_point, *min_point + target.movement());
+    *max_point = glm::max(*max_point, *max_point + target.movement());
+}
+
+std::vector<nextfloor::mesh::Mesh*> Ground::KeepEligibleNeighbors(
+  const nextfloor::mesh::Mesh& target,
+  const std::vector<nextfloor::mesh::Mesh*>& all_neighbors) const
+{
+    /* Each task writes its own flag, then neighbors are kept in order */
+    std::vector<char> eligible_flags(all_neighbors.size(), 0);
     tbb::parallel_for(0, (int)all_neighbors.size(), 1, [&](int i) {
-        auto neighbor = all_neighbors[i];
-        if (target.IsNeighborEligibleForCollision(*neighbor)) {
-            std::scoped_lock lock_map(neighbors_mutex);
-            collision_neighbors.push_back(neighbor);
-        }
+        eligible_flags[i] = target.IsNeighborEligibleForCollision(*all_neighbors[i]);
     });
 
+    std::vector<nextfloor::mesh::Mesh*> collision_neighbors(0);
+    for (auto cnt = 0; cnt < (int)all_neighbors.size(); cnt++) {
+        if (eligible_flags[cnt]) {
+            collision_neighbors.push_back(all_neighbors[cnt]);
+        }
+    }
+
+    using nextfloor::core::CommonServices;
+    CommonServices::getCollisionStats()->AddCandidates(all_neighbors.size());
+    CommonServices::getCollisionStats()->AddEligiblePairs(collision_neighbors.size());
+
     return collision_neighbors;
 }
 
+/**
+ *  Halo: adjacent grids are read through around the target bounds, boxes out of a grid are clamped away.
+ *  Empty adjacent grids are skipped from their parent grid bit, without reading their own mask
+ */
+void Ground::FindHaloNeighbors(const glm::vec3& min_point,
+                               const glm::vec3& max_point,
+                               std::vector<nextfloor::mesh::Mesh*>* neighbors) const
+{
+    for (auto& adjacent_ground : adjacent_grounds_) {
+        if (parent_grid_ == nullptr || parent_grid_->IsChildGridOccupied(adjacent_ground->location())) {
+            adjacent_ground->grid()->FindCollisionNeighbors(min_point, max_point, neighbors);
+        }
+    }
+    FindAdjacentStaticNeighbors(min_point, max_point, neighbors);
+}
+
+/**
+ *  Static trees of adjacent grounds only when bounds cross into them
+ */
+void Ground::FindAdjacentStaticNeighbors(const glm::vec3& min_point,
+                                         const glm::vec3& max_point,
+                                         std::vector<nextfloor::mesh::Mesh*>* neighbors) const
+{
+    for (auto& adjacent_ground : adjacent_grounds_) {
+        if (adjacent_ground->static_tree_ != nullptr) {
+            glm::vec3 ground_min_point = adjacent_ground->grid()->CalculateFirstPointInGrid();
+            glm::vec3 ground_max_point = ground_min_point + adjacent_ground->grid()->dimension();
+            if (min_point.x <= ground_max_point.x && max_point.x >= ground_min_point.x
+                && min_point.y <= ground_max_point.y && max_point.y >= ground_min_point.y
+                && min_point.z <= ground_max_point.z && max_point.z >= ground_min_point.z) {
+                std::vector<nextfloor::mesh::Mesh*> static_neighbors
+                  = adjacent_ground->static_tree_->FindCollisionNeighbors(min_point, max_point);
+                neighbors->insert(neighbors->end(), static_neighbors.begin(), static_neighbors.end());
+            }
+        }
+    }
+}
+
+void Ground::QueryBox(const glm::vec3& min_point,
+                      const glm::vec3& max_point,
+                      std::vector<nextfloor::mesh::Mesh*>* meshes) const
+{
+    grid()->QueryBox(min_point, max_point, meshes);
+    if (static_tree_ != nullptr) {
+        static_tree_->QueryBox(min_point, max_point, meshes);
+    }
+}
+
+void Ground::QuerySphere(const glm::vec3& center, float radius, std::vector<nextfloor::mesh::Mesh*>* meshes) const
+{
+    grid()->QuerySphere(center, radius, meshes);
+    if (static_tree_ != nullptr) {
+        static_tree_->QuerySphere(center, radius, meshes);
+    }
+}
+
+/**
+ *  Grid k nearer meshes, then the static tree ones nearer than them
+ */
+void Ground::QueryKNearest(const glm::vec3& point, int k, std::vector<nextfloor::mesh::Mesh*>* meshes) const
+{
+    int first_mesh = meshes->size();
+    grid()->QueryKNearest(point, k, meshes);
+    if (static_tree_ != nullptr) {
+        static_tree_->MergeKNearest(point, k, first_mesh, meshes);
+    }
+}
+
+Grid::RayHit Ground::RayCast(const glm::vec3& origin,
+                             const glm::vec3& direction,
+                             float max_distance,
+                             const Grid::MeshFilter& filter) const
+{
+    Grid::RayHit nearer_hit = grid()->RayCast(origin, direction, max_distance, filter);
+    if (static_tree_ == nullptr) {
+        return nearer_hit;
+    }
+
+    /* Same tie break than grids: lower id first at the same distance */
+    Grid::RayHit static_hit = static_tree_->RayCast(origin, direction, nearer_hit.distance, filter);
+    if (static_hit.mesh != nullptr
+        && (nearer_hit.mesh == nullptr || static_hit.distance < nearer_hit.distance
+            || static_hit.mesh->id() < nearer_hit.mesh->id())) {
+        nearer_hit = static_hit;
+    }
+
+    return nearer_hit;
+}
+
+Grid::RayHit Ground::SegmentCast(const glm::vec3& start_point,
+                                 const glm::vec3& end_point,
+                                 const Grid::MeshFilter& filter) const
+{
+    glm::vec3 segment = end_point - start_point;
+    return RayCast(start_point, segment, glm::length(segment), filter);
+}
+
 nextfloor::mesh::Mesh* Ground::UpdateChildPlacement(nextfloor::mesh::Mesh* child)
 {
-    if (IsInside(*child)) {
-        UpdateChildPlacementInGrid(child);
-        return this;
+    UpdateChildPlacementInGrid(child);
+    if (!IsInside(*child)) {
+        pending_transferts_.push_back(child);
     }
-    else {
-        return TransfertChildToNeighbor(child);
+
+    return this;
+}
+
+/**
+ *  A child back inside the ground (or already transferred) is kept
+ */
+void Ground::TransfertPendingChilds()
+{
+    for (auto& child : pending_transferts_) {
+        if (!IsInside(*child)) {
+            TransfertChildToNeighbor(child);
+        }
+    }
+
+    pending_transferts_.clear();
+}
+
+void Ground::AddGridOccupancyStats(Grid::OccupancyStats* stats) const
+{
+    Grid::OccupancyStats grid_stats = grid()->CalculateOccupancyStats();
+    for (auto load = 0; load < Grid::kLoadHistogramSize; load++) {
+        stats->load_histogram[load] += grid_stats.load_histogram[load];
+    }
+    stats->cells_count += grid_stats.cells_count;
+    stats->max_load = std::max(stats->max_load, grid_stats.max_load);
+    stats->objects_count += grid_stats.objects_count;
+    stats->placements += grid_stats.placements;
+    stats->query_boxes += grid_stats.query_boxes;
+}
+
+void Ground::AddAdjacentGround(Ground* ground)
+{
+    assert(ground != nullptr);
+    adjacent_grounds_.push_back(ground);
+}
+
+/**
+ *  Grid location is the ground one: parent grid bits are read back from the ground location
+ */
+void Ground::AttachToParentGrid(Grid* parent_grid)
+{
+    parent_grid_ = parent_grid;
+    grid()->set_parent_grid(parent_grid);
+}
+
+bool Ground::IsAdjacentTo(const Ground& ground) const
+{
+    if (&ground == this) {
+        return false;
+    }
+
+    glm::vec3 min_point = grid()->CalculateFirstPointInGrid();
+    glm::vec3 max_point = min_point + grid()->dimension();
+    glm::vec3 ground_min_point = ground.grid()->CalculateFirstPointInGrid();
+    glm::vec3 ground_max_point = ground_min_point + ground.grid()->dimension();
+    for (auto i = 0; i < 3; i++) {
+        if (min_point[i] > ground_max_point[i] + kAdjacencyTolerance
+            || max_point[i] < ground_min_point[i] - kAdjacencyTolerance) {
+            return false;
+        }
     }
+
+    return true;
 }
 
 void Ground::UpdateChildPlacementInGrid(nextfloor::mesh::Mesh* item)
 {
-    RemoveMeshToGrid(item);
-    AddMeshToGrid(item);
+    assert(grid_ != nullptr);
+    if (item->hasChilds() && !item->hasLayout()) {
+        for (auto& grant_child : item->childs()) {
+            UpdateChildPlacementInGrid(grant_child);
+        }
+    }
+    else {
+        grid_->UpdateItem(item);
+    }
 }
 
 
+/**
+ *  Adjacent grounds first, else the parent searches into all its childs
+ */
 nextfloor::mesh::Mesh* Ground::TransfertChildToNeighbor(nextfloor::mesh::Mesh* child)
 {
-    assert(parent_ != nullptr);
     assert(child != nullptr);
 
+    for (auto& adjacent_ground : adjacent_grounds_) {
+        if (adjacent_ground->IsInside(*child)) {
+            adjacent_ground->add_child(remove_child(child));
+            return adjacent_ground;
+        }
+    }
+
+    assert(parent_ != nullptr);
     return parent_->AddIntoChild(remove_child(child));
 }
 
@@ -83,6 +310,8 @@ nextfloor::mesh::Mesh* Ground::AddIntoChild(std::unique_ptr<nextfloor::mesh::Mes
         }
     }
 
+    /* Mesh is out of the grounds and will be deleted */
+    RemoveActiveObject(mesh_raw);
     return nullptr;
 }
 
@@ -109,6 +338,27 @@ std::unique_ptr<nextfloor::mesh::Mesh> Ground::remove_child(nextfloor::mesh::Mes
     return CompositeMesh::remove_child(child);
 }
 
+void Ground::AddActiveObject(nextfloor::mesh::Mesh* mesh)
+{
+    if (parent_ != nullptr) {
+        parent_->AddActiveObject(mesh);
+    }
+}
+
+void Ground::RemoveActiveObject(nextfloor::mesh::Mesh* mesh)
+{
+    if (parent_ != nullptr) {
+        parent_->RemoveActiveObject(mesh);
+    }
+}
+
+void Ground::RemoveStaticMesh(nextfloor::mesh::Mesh* mesh)
+{
+    if (static_tree_ != nullptr) {
+        static_tree_->RemoveMesh(mesh);
+    }
+}
+
 void Ground::RemoveMeshToGrid(nextfloor::mesh::Mesh* object)
 {
     assert(grid_ != nullptr);
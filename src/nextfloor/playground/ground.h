@@ -9,9 +9,13 @@
 
 #include "nextfloor/mesh/placement_mesh.h"
 
+#include <tbb/concurrent_vector.h>
+#include <glm/glm.hpp>
 #include <memory>
+#include <vector>
 
 #include "nextfloor/playground/grid.h"
+#include "nextfloor/playground/mesh_tree.h"
 #include "nextfloor/mesh/mesh.h"
 
 namespace nextfloor {
@@ -28,15 +32,57 @@ public:
     ~Ground() override = default;
 
     std::vector<nextfloor::mesh::Mesh*> FindCollisionNeighborsOf(const nextfloor::mesh::Mesh& target) const final;
+    std::vector<nextfloor::mesh::Mesh*> FindStaticNeighborsOf(const nextfloor::mesh::Mesh& target) const final;
     void AddMeshToGrid(nextfloor::mesh::Mesh* object);
     void RemoveMeshToGrid(nextfloor::mesh::Mesh* object);
     void UpdateChildPlacementInGrid(nextfloor::mesh::Mesh* object);
+    void RemoveStaticMesh(nextfloor::mesh::Mesh* mesh) final;
+
+    /* Active objects are managed by the universe, rooms forward them to it */
+    void AddActiveObject(nextfloor::mesh::Mesh* mesh) override;
+    void RemoveActiveObject(nextfloor::mesh::Mesh* mesh) override;
+    virtual void UpdateActiveObjects() {}
 
     nextfloor::mesh::Mesh* add_child(std::unique_ptr<nextfloor::mesh::Mesh> object) final;
     std::unique_ptr<nextfloor::mesh::Mesh> remove_child(nextfloor::mesh::Mesh* child) final;
 
+    /* A child out of the ground stays into it (clamped in grid) until the pending transferts of the frame */
     nextfloor::mesh::Mesh* UpdateChildPlacement(nextfloor::mesh::Mesh* child) final;
     nextfloor::mesh::Mesh* TransfertChildToNeighbor(nextfloor::mesh::Mesh* child);
+
+    /* Once by frame, after all moves: childs which have crossed the ground boundary are transferred */
+    virtual void TransfertPendingChilds();
+
+    /**
+     *  Grid queries, with the static tree meshes (wall bricks are out of the grid). Only this ground is queried
+     */
+    void QueryBox(const glm::vec3& min_point,
+                  const glm::vec3& max_point,
+                  std::vector<nextfloor::mesh::Mesh*>* meshes) const;
+    void QuerySphere(const glm::vec3& center, float radius, std::vector<nextfloor::mesh::Mesh*>* meshes) const;
+    void QueryKNearest(const glm::vec3& point, int k, std::vector<nextfloor::mesh::Mesh*>* meshes) const;
+
+    /**
+     *  Casts on the grid, then on the static tree (wall bricks are out of the grid) up to the grid hit.
+     *  Filter and max distance are the ones of Grid::RayCast, only this ground is crossed
+     */
+    Grid::RayHit RayCast(const glm::vec3& origin,
+                         const glm::vec3& direction,
+                         float max_distance,
+                         const Grid::MeshFilter& filter) const;
+    Grid::RayHit SegmentCast(const glm::vec3& start_point,
+                             const glm::vec3& end_point,
+                             const Grid::MeshFilter& filter) const;
+
+    /* Grid occupancy added to stats (max load is kept) */
+    virtual void AddGridOccupancyStats(Grid::OccupancyStats* stats) const;
+
+    /* Adjacent grounds are read for neighbors near the boundary, and tried first for transferts */
+    void AddAdjacentGround(Ground* ground);
+    bool IsAdjacentTo(const Ground& ground) const;
+
+    /* Two levels occupancy: the grid reports into the parent grid, whose bits gate the adjacent grids reads */
+    void AttachToParentGrid(Grid* parent_grid);
     nextfloor::mesh::Mesh* AddIntoChild(std::unique_ptr<nextfloor::mesh::Mesh> mesh) final;
 
     bool IsInside(const nextfloor::mesh::Mesh& mesh) const final;
@@ -56,9 +102,30 @@ public:
 
 protected:
     std::unique_ptr<Grid> grid_{nullptr};
+    /* Static meshes outside of the grid, optional */
+    std::unique_ptr<MeshTree> static_tree_{nullptr};
 
 private:
+    static constexpr float kAdjacencyTolerance = 0.001f;
+
     bool IsInside(const glm::vec3& location) const;
+    void CalculateSweptBounds(const nextfloor::mesh::Mesh& target, glm::vec3* min_point, glm::vec3* max_point) const;
+    std::vector<nextfloor::mesh::Mesh*> KeepEligibleNeighbors(
+      const nextfloor::mesh::Mesh& target,
+      const std::vector<nextfloor::mesh::Mesh*>& all_neighbors) const;
+    void FindHaloNeighbors(const glm::vec3& min_point,
+                           const glm::vec3& max_point,
+                           std::vector<nextfloor::mesh::Mesh*>* neighbors) const;
+    void FindAdjacentStaticNeighbors(const glm::vec3& min_point,
+                                     const glm::vec3& max_point,
+                                     std::vector<nextfloor::mesh::Mesh*>* neighbors) const;
+
+    /* Grounds touching this one, sides, edges or corners */
+    std::vector<Ground*> adjacent_grounds_;
+    Grid* parent_grid_{nullptr};
+
+    /* Childs moved out of the ground, filled concurrently by the moves */
+    tbb::concurrent_vector<nextfloor::mesh::Mesh*> pending_transferts_;
 };
 
 }  // namespace playground
@@ -0,0 +1,59 @@
+/**
+ *  @file mesh_tree.h
+ *  @brief MeshTree class header
+ *  @author Eric Fehr (ricofehr@nextdeploy.io, github: ricofehr)
+ */
+
+#ifndef NEXTFLOOR_PLAYGROUND_MESHTREE_H_
+#define NEXTFLOOR_PLAYGROUND_MESHTREE_H_
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "nextfloor/mesh/mesh.h"
+#include "nextfloor/playground/grid.h"
+
+namespace nextfloor {
+
+namespace playground {
+
+/**
+ *  @class MeshTree
+ *  @brief Interface for a bounding volume hierarchy of static meshes
+ */
+class MeshTree {
+
+public:
+    using RayHit = Grid::RayHit;
+    using MeshFilter = Grid::MeshFilter;
+
+    virtual ~MeshTree() = default;
+
+    virtual void Build(const std::vector<nextfloor::mesh::Mesh*>& meshes) = 0;
+    virtual void RemoveMesh(nextfloor::mesh::Mesh* mesh) = 0;
+    virtual std::vector<nextfloor::mesh::Mesh*> FindCollisionNeighbors(const glm::vec3& min_point,
+                                                                       const glm::vec3& max_point) const = 0;
+    /* Same queries than Grid ones, on the tree meshes */
+    virtual void QueryBox(const glm::vec3& min_point,
+                          const glm::vec3& max_point,
+                          std::vector<nextfloor::mesh::Mesh*>* meshes) const = 0;
+    virtual void QuerySphere(const glm::vec3& center,
+                             float radius,
+                             std::vector<nextfloor::mesh::Mesh*>* meshes) const = 0;
+    /* Buffer meshes (from first_mesh, not into the tree) and tree meshes: only the k nearer are kept, nearer first */
+    virtual void MergeKNearest(const glm::vec3& point,
+                               int k,
+                               int first_mesh,
+                               std::vector<nextfloor::mesh::Mesh*>* meshes) const = 0;
+    virtual RayHit RayCast(const glm::vec3& origin,
+                           const glm::vec3& direction,
+                           float max_distance,
+                           const MeshFilter& filter) const = 0;
+    virtual int size() const = 0;
+};
+
+}  // namespace playground
+
+}  // namespace nextfloor
+
+#endif  // NEXTFLOOR_PLAYGROUND_MESHTREE_H_
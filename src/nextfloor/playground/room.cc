@@ -7,17 +7,20 @@
 #include "nextfloor/playground/room.h"
 
 #include <utility>
+#include <vector>
 
 namespace nextfloor {
 
 namespace playground {
 
 Room::Room(std::unique_ptr<Grid> grid,
+           std::unique_ptr<MeshTree> static_tree,
            std::unique_ptr<nextfloor::mesh::Border> border,
            std::vector<std::unique_ptr<Wall>> walls,
            std::vector<std::unique_ptr<nextfloor::mesh::DynamicMesh>> objects)
 {
     grid_ = std::move(grid);
+    static_tree_ = std::move(static_tree);
     border_ = std::move(border);
     InitChilds(std::move(walls), std::move(objects));
     grid_->DisplayGrid();
@@ -26,9 +29,14 @@ Room::Room(std::unique_ptr<Grid> grid,
 void Room::InitChilds(std::vector<std::unique_ptr<Wall>> walls,
                       std::vector<std::unique_ptr<nextfloor::mesh::DynamicMesh>> objects)
 {
+    /* Wall bricks are static: into the tree, out of the grid */
+    std::vector<nextfloor::mesh::Mesh*> bricks;
     for (auto& wall : walls) {
-        add_child(std::move(wall));
+        std::vector<nextfloor::mesh::Mesh*> wall_bricks = wall->leafs();
+        bricks.insert(bricks.end(), wall_bricks.begin(), wall_bricks.end());
+        CompositeMesh::add_child(std::move(wall));
     }
+    static_tree_->Build(bricks);
 
     for (auto& object : objects) {
         add_child(std::move(object));
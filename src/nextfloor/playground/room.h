@@ -14,6 +14,7 @@
 #include <glm/glm.hpp>
 
 #include "nextfloor/playground/grid.h"
+#include "nextfloor/playground/mesh_tree.h"
 #include "nextfloor/playground/wall.h"
 #include "nextfloor/mesh/border.h"
 #include "nextfloor/mesh/dynamic_mesh.h"
@@ -30,6 +31,7 @@ class Room : public Ground {
 
 public:
     Room(std::unique_ptr<Grid> grid,
+         std::unique_ptr<MeshTree> static_tree,
          std::unique_ptr<nextfloor::mesh::Border> border,
          std::vector<std::unique_ptr<Wall>> walls,
          std::vector<std::unique_ptr<nextfloor::mesh::DynamicMesh>> objects);
@@ -20,8 +20,81 @@ Universe::Universe(std::unique_ptr<Grid> grid,
     border_ = std::move(border);
 
     for (auto& room : rooms) {
+        room->AttachToParentGrid(grid_.get());
+        rooms_.push_back(room.get());
         add_child(std::move(room));
     }
+
+    for (auto i = 0; i < (int)rooms_.size(); i++) {
+        for (auto j = i + 1; j < (int)rooms_.size(); j++) {
+            if (rooms_[i]->IsAdjacentTo(*rooms_[j])) {
+                rooms_[i]->AddAdjacentGround(rooms_[j]);
+                rooms_[j]->AddAdjacentGround(rooms_[i]);
+            }
+        }
+    }
+}
+
+void Universe::AddGridOccupancyStats(Grid::OccupancyStats* stats) const
+{
+    for (auto& room : rooms_) {
+        room->AddGridOccupancyStats(stats);
+    }
+}
+
+void Universe::TransfertPendingChilds()
+{
+    for (auto& room : rooms_) {
+        room->TransfertPendingChilds();
+    }
+}
+
+std::vector<nextfloor::mesh::Mesh*> Universe::GetMovingObjects()
+{
+    if (!is_active_objects_init_) {
+        for (auto& mesh : PlacementMesh::GetMovingObjects()) {
+            AddActiveObject(mesh);
+        }
+        is_active_objects_init_ = true;
+    }
+
+    std::vector<nextfloor::mesh::Mesh*> moving_objects;
+    for (auto& active_object : active_objects_) {
+        if (active_object.first->border()->IsMoved()) {
+            moving_objects.push_back(active_object.first);
+        }
+    }
+
+    return moving_objects;
+}
+
+void Universe::AddActiveObject(nextfloor::mesh::Mesh* mesh)
+{
+    tbb::concurrent_hash_map<nextfloor::mesh::Mesh*, int>::accessor accessor;
+    active_objects_.insert(accessor, mesh);
+    accessor->second = 0;
+}
+
+void Universe::RemoveActiveObject(nextfloor::mesh::Mesh* mesh)
+{
+    active_objects_.erase(mesh);
+}
+
+void Universe::UpdateActiveObjects()
+{
+    std::vector<nextfloor::mesh::Mesh*> sleeping_objects;
+    for (auto& active_object : active_objects_) {
+        if (active_object.first->border()->IsMoved()) {
+            active_object.second = 0;
+        }
+        else if (++active_object.second >= kFramesBeforeSleep) {
+            sleeping_objects.push_back(active_object.first);
+        }
+    }
+
+    for (auto& mesh : sleeping_objects) {
+        active_objects_.erase(mesh);
+    }
 }
 
 }  // namespace playground
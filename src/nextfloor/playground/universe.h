@@ -9,6 +9,7 @@
 
 #include "nextfloor/playground/ground.h"
 
+#include <tbb/concurrent_hash_map.h>
 #include <memory>
 #include <vector>
 
@@ -30,6 +31,30 @@ public:
              std::unique_ptr<nextfloor::mesh::Border> border,
              std::vector<std::unique_ptr<Ground>> rooms);
     ~Universe() final = default;
+
+    /* Only active objects are searched, the whole tree is walked at first call */
+    std::vector<nextfloor::mesh::Mesh*> GetMovingObjects() final;
+
+    void AddActiveObject(nextfloor::mesh::Mesh* mesh) final;
+    void RemoveActiveObject(nextfloor::mesh::Mesh* mesh) final;
+
+    /* Once by frame: objects without movement since kFramesBeforeSleep frames go to sleep */
+    void UpdateActiveObjects() final;
+
+    /* Rooms transfer their pending childs, adjacent rooms are linked at construction */
+    void TransfertPendingChilds() final;
+
+    /* Rooms grids only, the universe grid places the rooms themselves */
+    void AddGridOccupancyStats(Grid::OccupancyStats* stats) const final;
+
+private:
+    static constexpr int kFramesBeforeSleep = 30;
+
+    /* Active object and its count of frames without movement */
+    tbb::concurrent_hash_map<nextfloor::mesh::Mesh*, int> active_objects_;
+    bool is_active_objects_init_{false};
+
+    std::vector<Ground*> rooms_;
 };
 
 }  // namespace playground
@@ -29,6 +29,9 @@ std::vector<nextfloor::mesh::Mesh*> Wall::FindCollisionNeighborsOf(const Mesh& t
 std::unique_ptr<nextfloor::mesh::Mesh> Wall::remove_child(nextfloor::mesh::Mesh* child)
 {
     child->ClearCoords();
+    if (parent_ != nullptr) {
+        parent_->RemoveStaticMesh(child);
+    }
     return CompositeMesh::remove_child(child);
 }
 
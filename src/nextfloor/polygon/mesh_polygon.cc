@@ -28,7 +28,7 @@ void MeshPolygon::UpdateModelViewProjectionMatrix(const glm::mat4& view_projecti
 
 glm::mat4 MeshPolygon::GetModelMatrix()
 {
-    return glm::translate(glm::mat4(1.0f), location_);
+    return glm::translate(glm::mat4(1.0f), location_ - (1.0f - interpolation_) * last_step_move_);
 }
 
 }  // namespace polygon
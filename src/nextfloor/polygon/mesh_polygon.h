@@ -44,7 +44,15 @@ public:
 
     void set_distance_factor(float distance_factor) final { distance_factor_ = distance_factor; }
     void set_move_factor(glm::vec3 move_factor) final { move_factor_ = move_factor; }
-    void set_movement(const glm::vec3& movement) final { movement_ = movement; }
+    void set_movement(const glm::vec3& movement) final
+    {
+        movement_ = movement;
+        /* Stopped: no more step to interpolate */
+        if (!IsMoved()) {
+            last_step_move_ = glm::vec3(0.0f);
+        }
+    }
+    void set_interpolation(float interpolation) final { interpolation_ = interpolation; }
 
 protected:
     MeshPolygon() = default;
@@ -62,12 +70,17 @@ protected:
     float distance_factor_ = 1.0f;
     glm::vec3 move_factor_{1.0f, 1.0f, 1.0f};
 
+    /** Drawn location is between last two simulation steps (1 -> current location) */
+    glm::vec3 last_step_move_{0.0f, 0.0f, 0.0f};
+    float interpolation_ = 1.0f;
+
 private:
     glm::mat4 GetModelMatrix();
 
     inline void UpdateLocation()
     {
-        location_ += movement_ * distance_factor_;
+        last_step_move_ = movement_ * distance_factor_;
+        location_ += last_step_move_;
     }
 
     inline void UpdateMovement()
@@ -29,6 +29,8 @@ public:
     WallBrick(std::unique_ptr<nextfloor::mesh::Border> border,
               std::vector<std::unique_ptr<nextfloor::mesh::Polygon>> bricks);
     ~WallBrick() final = default;
+
+    bool IsStatic() const final { return true; }
 };
 
 }  // namespace scenery